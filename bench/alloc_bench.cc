@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Heap allocations per PAL request
+ *
+ * Issues random reads, programs and erases through synchronous interface of
+ * PAL model selected by config file, one request per call and then four
+ * requests per call. Operator new is counted, and only second half of each
+ * phase is measured, so buffers grown at warm up are not counted.
+ *
+ * Usage: alloc_bench <config file> [# of requests] [interval (ps)]
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+
+#include "bench/simulator.hh"
+#include "pal/pal.hh"
+#include "sim/config_reader.hh"
+#include "sim/log.hh"
+#include "util/old/SimpleSSD_types.h"
+
+using namespace SimpleSSD;
+
+static uint64_t allocCount = 0;
+
+void *operator new(size_t size) {
+  void *ptr = malloc(size > 0 ? size : 1);
+
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+
+  allocCount++;
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+  free(ptr);
+}
+
+int main(int argc, char *argv[]) {
+  const uint64_t eraseInterval = 64;  // One erase per 64 requests
+  const uint64_t batchSize[2] = {1, 4};  // Requests per call
+  BenchSimulator sim;
+  ConfigReader conf;
+  uint64_t count = 10000;
+  uint64_t interval = 100000000;
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <config file> [# of requests] [interval (ps)]" << std::endl;
+
+    return 1;
+  }
+
+  if (argc > 2) {
+    count = strtoull(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    interval = strtoull(argv[3], nullptr, 10);
+  }
+
+  setSimulator(&sim);
+  initLogSystem(nullptr, &std::cerr);  // No debug log per command
+
+  if (!conf.init(argv[1])) {
+    std::cerr << "Failed to read config file " << argv[1] << std::endl;
+
+    return 1;
+  }
+
+  PAL::PAL pal(conf);
+  PAL::Parameter *param = pal.getInfo();
+  std::mt19937_64 gen(1);
+  std::vector<PAL::Request> list(batchSize[1],
+                                 PAL::Request(param->pageInSuperPage));
+  uint64_t now = 0;
+
+  for (auto &iter : list) {
+    iter.ioFlag.set();
+  }
+
+  for (uint64_t size : batchSize) {
+    uint64_t allocated = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+      uint64_t before = allocCount;
+      uint64_t tick;
+      int oper = gen() % 3 == 0 ? OPER_WRITE : OPER_READ;
+
+      now += interval;
+      sim.run(now);
+
+      if (i % eraseInterval == eraseInterval - 1) {
+        oper = OPER_ERASE;
+      }
+
+      for (uint64_t j = 0; j < size; j++) {
+        list[j].blockIndex = gen() % param->superBlock;
+        list[j].pageIndex = oper == OPER_ERASE ? 0 : gen() % param->page;
+      }
+
+      tick = now;
+
+      if (size == 1) {
+        switch (oper) {
+          case OPER_READ:
+            pal.read(list[0], tick);
+            break;
+          case OPER_WRITE:
+            pal.write(list[0], tick);
+            break;
+          default:
+            pal.erase(list[0], tick);
+            break;
+        }
+      }
+      else {
+        switch (oper) {
+          case OPER_READ:
+            pal.read(list, tick);
+            break;
+          case OPER_WRITE:
+            pal.write(list, tick);
+            break;
+          default:
+            pal.erase(list, tick);
+            break;
+        }
+      }
+
+      if (i >= count / 2) {
+        allocated += allocCount - before;
+      }
+    }
+
+    printf("%" PRIu64 " request(s) per call  %.3f allocations per request\n",
+           size, (double)allocated / (count - count / 2) / size);
+  }
+
+  return 0;
+}
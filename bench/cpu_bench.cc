@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput of CPU job pipeline (submit, schedule and complete)
+ *
+ * Operator new is counted, so heap allocations per job are printed with
+ * throughput. Allocation count does not depend on host load.
+ *
+ * Usage: cpu_bench <config file> [# of jobs]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "bench/simulator.hh"
+#include "sim/config_reader.hh"
+#include "sim/cpu.hh"
+#include "sim/log.hh"
+
+using namespace SimpleSSD;
+
+static uint64_t allocCount = 0;
+
+void *operator new(size_t size) {
+  void *ptr = malloc(size > 0 ? size : 1);
+
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+
+  allocCount++;
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+  free(ptr);
+}
+
+struct Request {
+  uint64_t slpn;
+  uint64_t nlp;
+  uint64_t offset;
+};
+
+// Submit jobs in batch and wait for completion of each batch
+double run(BenchSimulator &sim, uint64_t count, int kind,
+           uint64_t &allocated) {
+  const uint64_t batch = 16;
+  uint64_t done = 0;
+  uint64_t sum = 0;
+  uint64_t before = allocCount;
+
+  auto begin = std::chrono::steady_clock::now();
+
+  for (uint64_t i = 0; i < count; i += batch) {
+    for (uint64_t j = 0; j < batch; j++) {
+      Request req = {i, j, 1};
+
+      if (kind == 0) {
+        DMAFunction func = [&done](uint64_t, void *) { done++; };
+
+        execute(CPU::NVME__CONTROLLER, CPU::WORK, std::move(func));
+      }
+      else {
+        DMAFunction func = [&done, &sum, req](uint64_t, void *) {
+          done++;
+          sum += req.slpn + req.nlp + req.offset;
+        };
+
+        if (kind == 1) {
+          execute(CPU::NVME__CONTROLLER, CPU::WORK, std::move(func));
+        }
+        else {
+          cpuHandler(sim.getCurrentTick(),
+                     new CPUContext(std::move(func), nullptr,
+                                    CPU::NVME__CONTROLLER, CPU::WORK));
+        }
+      }
+    }
+
+    while (done < i + batch && sim.step()) {
+    }
+  }
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+
+  allocated = allocCount - before;
+
+  if (done < count) {
+    std::cerr << "Only " << done << " of " << count << " jobs finished"
+              << std::endl;
+
+    exit(1);
+  }
+
+  return done / elapsed.count();
+}
+
+int main(int argc, char *argv[]) {
+  const char *name[] = {"small capture", "large capture",
+                        "through CPUContext"};
+  BenchSimulator sim;
+  ConfigReader conf;
+  uint64_t count = 2000000;
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <config file> [# of jobs]"
+              << std::endl;
+
+    return 1;
+  }
+
+  if (argc > 2) {
+    count = strtoull(argv[2], nullptr, 10);
+  }
+
+  setSimulator(&sim);
+  initLogSystem(&std::cout, &std::cerr);
+
+  if (!conf.init(argv[1])) {
+    std::cerr << "Failed to read config file " << argv[1] << std::endl;
+
+    return 1;
+  }
+
+  initCPU(conf);
+
+  for (int kind = 0; kind < 3; kind++) {
+    uint64_t allocated;
+    double rate = run(sim, count, kind, allocated);
+
+    printf("%-20s %.2f Mjobs/s  %.3f allocations per job\n", name[kind],
+           rate / 1000000., (double)allocated / count);
+  }
+
+  deInitCPU();
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Queued DRAM controller under mixed data and metadata traffic
+ *
+ * Data transfers are submitted through asynchronous interface, mapping table
+ * updates are posted, and mapping table lookups use synchronous read, like
+ * ICL and FTL do.
+ *
+ * Usage: dram_bench <config file> [# of requests] [interval (ps)]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "bench/simulator.hh"
+#include "dram/timing.hh"
+#include "sim/config_reader.hh"
+#include "sim/log.hh"
+
+using namespace SimpleSSD;
+
+struct Latency {
+  uint64_t count;
+  uint64_t sum;
+
+  Latency() : count(0), sum(0) {}
+
+  void add(uint64_t latency) {
+    count++;
+    sum += latency;
+  }
+
+  double average() { return count > 0 ? (double)sum / count : 0.; }
+};
+
+int main(int argc, char *argv[]) {
+  const uint64_t dataSize = 4096;
+  const uint64_t dataRegionSize = 64 * 1024 * 1024;
+  const uint64_t metaRegionSize = 8 * 1024 * 1024;
+  BenchSimulator sim;
+  ConfigReader conf;
+  uint64_t count = 100000;
+  uint64_t interval = 1000000;
+  Latency latency[3];  // Data read, data write, mapping lookup
+  std::vector<Stats> list;
+  std::vector<double> values;
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <config file> [# of requests] [interval (ps)]" << std::endl;
+
+    return 1;
+  }
+
+  if (argc > 2) {
+    count = strtoull(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    interval = strtoull(argv[3], nullptr, 10);
+  }
+
+  setSimulator(&sim);
+  initLogSystem(&std::cout, &std::cerr);
+
+  if (!conf.init(argv[1])) {
+    std::cerr << "Failed to read config file " << argv[1] << std::endl;
+
+    return 1;
+  }
+
+  DRAM::TimingDRAM dram(conf);
+  uint32_t dataRegion = dram.addRegion("data", dataRegionSize);
+  uint32_t metaRegion = dram.addRegion("meta", metaRegionSize);
+  std::mt19937_64 gen(1);
+  uint64_t done = 0;
+
+  DMAFunction dataDone[2];
+
+  for (int write = 0; write < 2; write++) {
+    dataDone[write] = [&latency, &done, write](uint64_t tick, void *context) {
+      latency[write].add(tick - (uint64_t)context);
+      done++;
+    };
+  }
+
+  for (uint64_t i = 0; i < count; i++) {
+    uint64_t now = (i + 1) * interval;
+    uint64_t tick;
+    bool write = gen() % 2;
+
+    sim.run(now);
+
+    // Data transfer between host and cache
+    dram.submit(
+        dram.getAddress(dataRegion, gen() % (dataRegionSize / dataSize) *
+                                        dataSize),
+        dataSize, write, dataDone[write], (void *)now);
+
+    // Mapping table lookup
+    uint64_t meta = gen() % (metaRegionSize / 8) * 8;
+
+    tick = now;
+    dram.read(dram.getAddress(metaRegion, meta), 8, tick);
+    latency[2].add(tick - now);
+
+    // Mapping table update after program
+    if (write) {
+      dram.post(dram.getAddress(metaRegion, meta), 8, tick);
+    }
+  }
+
+  while (done < count && sim.step()) {
+  }
+
+  printf("data read       %.1f ns\n", latency[0].average() / 1000.);
+  printf("data write      %.1f ns\n", latency[1].average() / 1000.);
+  printf("mapping lookup  %.1f ns\n", latency[2].average() / 1000.);
+
+  dram.getStatList(list, "dram.");
+  dram.getStatValues(values);
+
+  for (uint32_t i = 0; i < list.size(); i++) {
+    printf("%-40s %.0f\n", list[i].name.c_str(), values[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Random I/O through cache, FTL and PAL
+ *
+ * Range is filled by sequential write first, then statistics are reset and
+ * random reads/writes are issued at fixed interval. Prints average latency
+ * and all statistics of ICL, DRAM, FTL and PAL.
+ *
+ * Usage: icl_bench <config file> [# of requests] [write ratio (%)]
+ *                  [request size] [range size] [interval (ps)]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "bench/simulator.hh"
+#include "icl/icl.hh"
+#include "sim/config_reader.hh"
+#include "sim/cpu.hh"
+#include "sim/log.hh"
+#include "util/algorithm.hh"
+
+using namespace SimpleSSD;
+
+struct Latency {
+  uint64_t count;
+  uint64_t sum;
+
+  Latency() : count(0), sum(0) {}
+
+  void add(uint64_t latency) {
+    count++;
+    sum += latency;
+  }
+
+  double average() { return count > 0 ? (double)sum / count : 0.; }
+};
+
+// Convert byte range to request of logical pages
+void makeRequest(ICL::Request &req, uint64_t offset, uint64_t length,
+                 uint32_t pageSize) {
+  req.reqID++;
+  req.offset = offset % pageSize;
+  req.length = length;
+  req.range.slpn = offset / pageSize;
+  req.range.nlp = (req.offset + length + pageSize - 1) / pageSize;
+}
+
+int main(int argc, char *argv[]) {
+  BenchSimulator sim;
+  ConfigReader conf;
+  uint64_t count = 100000;
+  uint64_t writeRatio = 50;
+  uint64_t size = 4096;
+  uint64_t range = 256 * 1024 * 1024;
+  uint64_t interval = 100000000;
+  Latency latency[2];  // Read, write
+  std::vector<Stats> list;
+  std::vector<double> values;
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <config file> [# of requests] [write ratio (%)]"
+                 " [request size] [range size] [interval (ps)]"
+              << std::endl;
+
+    return 1;
+  }
+
+  if (argc > 2) {
+    count = strtoull(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    writeRatio = strtoull(argv[3], nullptr, 10);
+  }
+  if (argc > 4) {
+    size = strtoull(argv[4], nullptr, 10);
+  }
+  if (argc > 5) {
+    range = strtoull(argv[5], nullptr, 10);
+  }
+  if (argc > 6) {
+    interval = strtoull(argv[6], nullptr, 10);
+  }
+
+  setSimulator(&sim);
+  initLogSystem(nullptr, &std::cerr);  // No debug log per request
+
+  if (!conf.init(argv[1])) {
+    std::cerr << "Failed to read config file " << argv[1] << std::endl;
+
+    return 1;
+  }
+
+  initCPU(conf);
+
+  ICL::ICL icl(conf);
+  ICL::Request req;
+  std::mt19937_64 gen(1);
+  uint64_t totalPages;
+  uint32_t pageSize;
+  uint64_t tick = 0;
+  uint64_t now;
+
+  icl.getLPNInfo(totalPages, pageSize);
+
+  range = MIN(range, totalPages * pageSize) / size * size;
+
+  if (range == 0) {
+    std::cerr << "Range is smaller than request size" << std::endl;
+
+    return 1;
+  }
+
+  // Fill range, so reads and partial writes find mapped pages
+  for (uint64_t offset = 0; offset < range; offset += pageSize) {
+    sim.run(tick);
+
+    makeRequest(req, offset, MIN(pageSize, range - offset), pageSize);
+    icl.write(req, tick);
+  }
+
+  LPNRange all(0, totalPages);
+
+  icl.flush(all, tick);
+
+  // Written line is not accessible until its flash write is finished
+  now = tick;
+
+  for (uint64_t offset = 0; offset < range; offset += pageSize) {
+    uint64_t finishedAt = tick;
+
+    makeRequest(req, offset, MIN(pageSize, range - offset), pageSize);
+    icl.read(req, finishedAt);
+
+    now = MAX(now, finishedAt);
+  }
+
+  sim.run(now);
+  icl.resetStatValues();
+  resetCPUStatValues();
+
+  for (uint64_t i = 0; i < count; i++) {
+    bool write = gen() % 100 < writeRatio;
+
+    now += interval;
+    sim.run(now);
+
+    makeRequest(req, gen() % (range / size) * size, size, pageSize);
+    tick = now;
+
+    if (write) {
+      icl.write(req, tick);
+    }
+    else {
+      icl.read(req, tick);
+    }
+
+    latency[write].add(tick - now);
+  }
+
+  printf("read   %.1f us\n", latency[0].average() / 1000000.);
+  printf("write  %.1f us\n", latency[1].average() / 1000000.);
+
+  icl.getStatList(list, "");
+  icl.getStatValues(values);
+
+  for (uint32_t i = 0; i < list.size(); i++) {
+    printf("%-40s %.0f\n", list[i].name.c_str(), values[i]);
+  }
+
+  deInitCPU();
+
+  return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Event-driven PAL under mixed read/program traffic
+ *
+ * Reads and programs are submitted through asynchronous interface, so they
+ * go through per-die queues and scheduler. Erases are issued synchronously
+ * like FTL garbage collection does, interleaved with queued commands.
+ *
+ * Usage: pal_bench <config file> [# of requests] [interval (ps)]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "bench/simulator.hh"
+#include "pal/pal.hh"
+#include "sim/config_reader.hh"
+#include "sim/log.hh"
+
+using namespace SimpleSSD;
+
+struct Latency {
+  uint64_t count;
+  uint64_t sum;
+
+  Latency() : count(0), sum(0) {}
+
+  void add(uint64_t latency) {
+    count++;
+    sum += latency;
+  }
+
+  double average() { return count > 0 ? (double)sum / count : 0.; }
+};
+
+int main(int argc, char *argv[]) {
+  const uint64_t eraseInterval = 64;  // One erase per 64 requests
+  BenchSimulator sim;
+  ConfigReader conf;
+  uint64_t count = 10000;
+  uint64_t interval = 200000000;
+  Latency latency[3];  // Read, program, erase
+  std::vector<Stats> list;
+  std::vector<double> values;
+
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <config file> [# of requests] [interval (ps)]" << std::endl;
+
+    return 1;
+  }
+
+  if (argc > 2) {
+    count = strtoull(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    interval = strtoull(argv[3], nullptr, 10);
+  }
+
+  setSimulator(&sim);
+  initLogSystem(nullptr, &std::cerr);  // No debug log per command
+
+  if (!conf.init(argv[1])) {
+    std::cerr << "Failed to read config file " << argv[1] << std::endl;
+
+    return 1;
+  }
+
+  if (conf.readInt(CONFIG_PAL, PAL::PAL_MODEL) != PAL::EVENT_MODEL) {
+    std::cerr << "Asynchronous interface needs event-driven PAL model"
+              << std::endl;
+
+    return 1;
+  }
+
+  PAL::PAL pal(conf);
+  PAL::Parameter *param = pal.getInfo();
+  std::mt19937_64 gen(1);
+  uint64_t submitted = 0;
+  uint64_t done = 0;
+
+  DMAFunction requestDone[2];
+
+  for (int write = 0; write < 2; write++) {
+    requestDone[write] = [&latency, &done, write](uint64_t tick,
+                                                  void *context) {
+      latency[write].add(tick - (uint64_t)context);
+      done++;
+    };
+  }
+
+  for (uint64_t i = 0; i < count; i++) {
+    uint64_t now = (i + 1) * interval;
+    PAL::Request req(param->pageInSuperPage);
+
+    sim.run(now);
+
+    req.blockIndex = gen() % param->superBlock;
+    req.ioFlag.set();
+
+    if (i % eraseInterval == eraseInterval - 1) {
+      uint64_t tick = now;
+
+      // Garbage collection
+      req.pageIndex = 0;
+      pal.erase(req, tick);
+      latency[2].add(tick - now);
+    }
+    else {
+      bool write = gen() % 3 == 0;
+
+      req.pageIndex = gen() % param->page;
+      submitted++;
+
+      if (write) {
+        pal.write(req, requestDone[write], (void *)now);
+      }
+      else {
+        pal.read(req, requestDone[write], (void *)now);
+      }
+    }
+  }
+
+  while (done < submitted && sim.step()) {
+  }
+
+  if (done < submitted) {
+    std::cerr << "Only " << done << " of " << submitted
+              << " requests finished" << std::endl;
+
+    return 1;
+  }
+
+  printf("read     %.1f us\n", latency[0].average() / 1000000.);
+  printf("program  %.1f us\n", latency[1].average() / 1000000.);
+  printf("erase    %.1f us\n", latency[2].average() / 1000000.);
+
+  pal.getStatList(list, "");
+  pal.getStatValues(values);
+
+  for (uint32_t i = 0; i < list.size(); i++) {
+    printf("%-40s %.0f\n", list[i].name.c_str(), values[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef __BENCH_SIMULATOR__
+#define __BENCH_SIMULATOR__
+
+#include <limits>
+#include <set>
+#include <vector>
+
+#include "sim/simulator.hh"
+
+namespace SimpleSSD {
+
+// Minimal event queue for benchmark programs
+class BenchSimulator : public Simulator {
+ private:
+  typedef std::pair<uint64_t, Event> Entry;
+
+  uint64_t tick;
+  std::vector<EventFunction> events;
+  std::vector<uint64_t> scheduledAt;
+  std::set<Entry> queue;
+
+ public:
+  BenchSimulator() : tick(0) {}
+
+  uint64_t getCurrentTick() override { return tick; }
+
+  Event allocateEvent(EventFunction func) override {
+    events.push_back(func);
+    scheduledAt.push_back(std::numeric_limits<uint64_t>::max());
+
+    return events.size() - 1;
+  }
+
+  void scheduleEvent(Event eid, uint64_t when) override {
+    descheduleEvent(eid);
+
+    scheduledAt[eid] = when;
+    queue.insert(Entry(when, eid));
+  }
+
+  void descheduleEvent(Event eid) override {
+    if (scheduledAt[eid] != std::numeric_limits<uint64_t>::max()) {
+      queue.erase(Entry(scheduledAt[eid], eid));
+      scheduledAt[eid] = std::numeric_limits<uint64_t>::max();
+    }
+  }
+
+  bool isScheduled(Event eid, uint64_t *when) override {
+    if (scheduledAt[eid] == std::numeric_limits<uint64_t>::max()) {
+      return false;
+    }
+
+    if (when) {
+      *when = scheduledAt[eid];
+    }
+
+    return true;
+  }
+
+  void deallocateEvent(Event eid) override { descheduleEvent(eid); }
+
+  // Process one event
+  bool step() {
+    if (queue.empty()) {
+      return false;
+    }
+
+    Entry entry = *queue.begin();
+
+    queue.erase(queue.begin());
+    scheduledAt[entry.second] = std::numeric_limits<uint64_t>::max();
+    tick = entry.first;
+
+    events[entry.second](tick);
+
+    return true;
+  }
+
+  // Process all events until when, then advance current tick to when
+  void run(uint64_t when) {
+    while (!queue.empty() && queue.begin()->first <= when) {
+      step();
+    }
+
+    tick = when;
+  }
+};
+
+}  // namespace SimpleSSD
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Free slot timeline of PAL, against map based implementation
+ *
+ * Reserves random slots on one resource the way PAL does (find free slot,
+ * insert reservation, flush old slots), with both FreeSlotList and the map
+ * of maps PAL2 used before. Every result is compared, then same operations
+ * are timed on each implementation.
+ *
+ * Usage: timeline_bench [# of reservations]
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "pal/old/PAL2_TimeSlot.h"
+
+// Free slots of PAL2 before flat arrays, one map of slots per size class
+class MapFreeSlotList {
+ private:
+  typedef std::map<uint64_t, uint64_t> SlotMap;
+
+  std::map<uint64_t, SlotMap> slots;
+
+  void AddFreeSlot(uint64_t tickLen, uint64_t tickFrom) {
+    auto e = slots.upper_bound(tickLen);
+
+    if (e != slots.begin()) {
+      e--;
+      e->second.insert(std::make_pair(tickFrom, tickFrom + tickLen - 1));
+    }
+  }
+
+ public:
+  void AddClass(uint64_t tickLen) { slots[tickLen]; }
+
+  bool FindFreeTime(uint64_t tickLen, uint64_t tickFrom, uint64_t &startTick,
+                    bool &conflicts) {
+    auto e = slots.upper_bound(tickLen);
+
+    if (e == slots.end()) {
+      e--;
+
+      auto f = e->second.upper_bound(tickFrom);
+
+      if (f != e->second.begin()) {
+        f--;
+
+        if (f->second >= tickLen + tickFrom - 1) {
+          startTick = f->first;
+          conflicts = false;
+
+          return true;
+        }
+
+        f++;
+      }
+
+      for (; f != e->second.end(); f++) {
+        if (f->second >= tickLen + f->first - 1) {
+          startTick = f->first;
+          conflicts = true;
+
+          return true;
+        }
+      }
+
+      conflicts = false;
+
+      return false;
+    }
+
+    if (e != slots.begin()) {
+      e--;
+    }
+
+    uint64_t minTick = (uint64_t)-1;
+
+    for (; e != slots.end(); e++) {
+      auto f = e->second.upper_bound(tickFrom);
+
+      if (f != e->second.begin()) {
+        f--;
+
+        if (f->second >= tickLen + tickFrom - 1) {
+          startTick = f->first;
+          conflicts = false;
+
+          return true;
+        }
+
+        f++;
+      }
+
+      for (; f != e->second.end(); f++) {
+        if (f->second >= tickLen + f->first - 1) {
+          if (minTick == (uint64_t)-1 || minTick > f->first) {
+            conflicts = true;
+            minTick = f->first;
+          }
+
+          break;
+        }
+      }
+    }
+
+    if (minTick == (uint64_t)-1) {
+      conflicts = false;
+
+      return false;
+    }
+
+    startTick = minTick;
+
+    return true;
+  }
+
+  void InsertFreeSlot(uint64_t tickLen, uint64_t tickFrom, uint64_t startTick,
+                      uint64_t &startPoint, bool split) {
+    if (startTick == startPoint) {
+      if (tickFrom == startTick) {
+        if (split) {
+          AddFreeSlot(tickLen, startPoint);
+        }
+
+        startPoint = startPoint + tickLen;
+      }
+      else {
+        assert(tickFrom > startTick);
+
+        if (split) {
+          AddFreeSlot(tickLen, tickFrom);
+        }
+
+        startPoint = tickFrom + tickLen;
+        AddFreeSlot(tickFrom - startTick, startTick);
+      }
+
+      return;
+    }
+
+    auto e = slots.upper_bound(tickLen);
+
+    if (e != slots.begin()) {
+      e--;
+    }
+
+    for (; e != slots.end(); e++) {
+      auto f = e->second.find(startTick);
+
+      if (f == e->second.end()) {
+        continue;
+      }
+
+      uint64_t tmpStartTick = f->first;
+      uint64_t tmpEndTick = f->second;
+
+      e->second.erase(f);
+
+      if (tmpStartTick < tickFrom) {
+        AddFreeSlot(tickFrom - tmpStartTick, tmpStartTick);
+
+        if (split) {
+          AddFreeSlot(tickLen, tickFrom);
+        }
+      }
+      else if (split) {
+        AddFreeSlot(tickLen, tmpStartTick);
+      }
+
+      if (tmpEndTick > tickLen + tickFrom - 1) {
+        AddFreeSlot(tmpEndTick - (tickFrom + tickLen - 1), tickFrom + tickLen);
+      }
+
+      break;
+    }
+  }
+
+  void FlushFreeSlots(uint64_t currentTick) {
+    for (auto &e : slots) {
+      auto f = e.second.begin();
+
+      while (f != e.second.end() && f->second < currentTick) {
+        f = e.second.erase(f);
+      }
+    }
+  }
+};
+
+struct Operation {
+  uint64_t tickLen;
+  uint64_t tickFrom;
+  bool split;
+  bool flush;
+};
+
+// Reserve slot like EventPAL::reserveChannel, returns begin tick
+template <class T>
+uint64_t reserve(T &list, uint64_t &startPoint, Operation &op) {
+  uint64_t slotBeginAt;
+  uint64_t beginAt;
+  bool conflicts;
+
+  if (op.flush && op.tickFrom > TIMESLOT_WINDOW) {
+    list.FlushFreeSlots(op.tickFrom - TIMESLOT_WINDOW);
+  }
+
+  if (list.FindFreeTime(op.tickLen, op.tickFrom, slotBeginAt, conflicts)) {
+    beginAt = op.tickFrom > slotBeginAt ? op.tickFrom : slotBeginAt;
+  }
+  else {
+    slotBeginAt = startPoint;
+    beginAt = op.tickFrom > slotBeginAt ? op.tickFrom : slotBeginAt;
+  }
+
+  list.InsertFreeSlot(op.tickLen, beginAt, slotBeginAt, startPoint, op.split);
+
+  return beginAt;
+}
+
+template <class T>
+double measure(std::vector<Operation> &ops, std::vector<uint64_t> &result) {
+  T list;
+  uint64_t startPoint = 0;
+  auto begin = std::chrono::steady_clock::now();
+
+  // Size classes of channel in PAL2 with sample config (400MHz, 16KB page)
+  list.AddClass(12500);
+  list.AddClass(25000);
+  list.AddClass(187500);
+  list.AddClass(23125000);
+  list.AddClass(23137500);
+
+  for (uint64_t i = 0; i < ops.size(); i++) {
+    result[i] = reserve(list, startPoint, ops[i]);
+  }
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+
+  return ops.size() / elapsed.count();
+}
+
+int main(int argc, char *argv[]) {
+  // Shorter than all classes, command, status, data in/out
+  const uint64_t length[5] = {5000, 12500, 25000, 187500, 23137500};
+  uint64_t count = 1000000;
+  std::mt19937_64 gen(1);
+  std::vector<Operation> ops;
+  std::vector<uint64_t> expected;
+  std::vector<uint64_t> result;
+  uint64_t now = 0;
+  uint64_t mismatch = 0;
+
+  if (argc > 1) {
+    count = strtoull(argv[1], nullptr, 10);
+  }
+
+  ops.resize(count);
+  expected.resize(count);
+  result.resize(count);
+
+  // Requests arrive out of order (MEM phases of dies end at any time), so
+  // gaps are left behind startPoint and filled later
+  for (auto &op : ops) {
+    now += gen() % 16000000;
+
+    op.tickLen = length[gen() % 5];
+    op.tickFrom = now + gen() % 50000000;
+    op.split = gen() % 16 == 0;
+    op.flush = gen() % 64 == 0;
+  }
+
+  double mapRate = measure<MapFreeSlotList>(ops, expected);
+  double listRate = measure<FreeSlotList>(ops, result);
+
+  for (uint64_t i = 0; i < count; i++) {
+    if (expected[i] != result[i]) {
+      if (mismatch++ == 0) {
+        printf("First mismatch at %" PRIu64 ": %" PRIu64 " != %" PRIu64 "\n",
+               i, result[i], expected[i]);
+      }
+    }
+  }
+
+  printf("map of maps    %.0f reservations/s\n", mapRate);
+  printf("FreeSlotList   %.0f reservations/s\n", listRate);
+  printf("mismatch       %" PRIu64 " / %" PRIu64 "\n", mismatch, count);
+
+  return mismatch > 0 ? 1 : 0;
+}
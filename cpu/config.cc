@@ -30,12 +30,40 @@ const char NAME_CLOCK[] = "ClockSpeed";
 const char NAME_CORE_HIL[] = "HILCoreCount";
 const char NAME_CORE_ICL[] = "ICLCoreCount";
 const char NAME_CORE_FTL[] = "FTLCoreCount";
+const char NAME_WORK_STEALING[] = "WorkStealing";
+const char NAME_STEAL_LATENCY[] = "StealLatency";
+const char NAME_CLOCK_HIL[] = "HILClockSpeed";
+const char NAME_CLOCK_ICL[] = "ICLClockSpeed";
+const char NAME_CLOCK_FTL[] = "FTLClockSpeed";
+const char NAME_DVFS_GOVERNOR[] = "DVFSGovernor";
+const char NAME_DVFS_INTERVAL[] = "DVFSInterval";
+const char NAME_DVFS_LEVEL[] = "DVFSLevel";
+const char NAME_DVFS_UP_THRESHOLD[] = "DVFSUpThreshold";
+const char NAME_DVFS_DOWN_THRESHOLD[] = "DVFSDownThreshold";
+const char NAME_DYNAMIC_POWER[] = "CoreDynamicPower";
+const char NAME_LEAKAGE_POWER[] = "CoreLeakagePower";
+const char NAME_PROFILE_FILE[] = "ProfileFile";
+const char NAME_FOLDED_STACK_FILE[] = "FoldedStackFile";
 
 Config::Config() {
   clock = 400000000;
   hilCore = 1;
   iclCore = 1;
   ftlCore = 1;
+  stealPolicy = STEAL_DISABLED;
+  stealLatency = 100000;
+  hilClock = 0;
+  iclClock = 0;
+  ftlClock = 0;
+  governor = GOVERNOR_NONE;
+  interval = 100000000;
+  level = 4;
+  upThreshold = 80;
+  downThreshold = 30;
+  dynamicPower = 40.f;
+  leakagePower = 5.f;
+  profileFile = "";
+  foldedStackFile = "";
 }
 
 bool Config::setConfig(const char *name, const char *value) {
@@ -53,6 +81,48 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_CORE_FTL)) {
     ftlCore = (uint32_t)strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_WORK_STEALING)) {
+    stealPolicy = (STEAL_POLICY)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_STEAL_LATENCY)) {
+    stealLatency = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_CLOCK_HIL)) {
+    hilClock = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_CLOCK_ICL)) {
+    iclClock = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_CLOCK_FTL)) {
+    ftlClock = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DVFS_GOVERNOR)) {
+    governor = (GOVERNOR)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DVFS_INTERVAL)) {
+    interval = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DVFS_LEVEL)) {
+    level = (uint32_t)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DVFS_UP_THRESHOLD)) {
+    upThreshold = (uint32_t)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DVFS_DOWN_THRESHOLD)) {
+    downThreshold = (uint32_t)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DYNAMIC_POWER)) {
+    dynamicPower = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_LEAKAGE_POWER)) {
+    leakagePower = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_PROFILE_FILE)) {
+    profileFile = value;
+  }
+  else if (MATCH_NAME(NAME_FOLDED_STACK_FILE)) {
+    foldedStackFile = value;
+  }
   else {
     ret = false;
   }
@@ -64,6 +134,48 @@ void Config::update() {
   if (clock == 0) {
     panic("Invalid ClockSpeed");
   }
+
+  if (stealPolicy > STEAL_ACROSS_LAYER) {
+    panic("Invalid WorkStealing");
+  }
+
+  if (hilClock == 0) {
+    hilClock = clock;
+  }
+  if (iclClock == 0) {
+    iclClock = clock;
+  }
+  if (ftlClock == 0) {
+    ftlClock = clock;
+  }
+
+  if (governor > GOVERNOR_QUEUE_DEPTH) {
+    panic("Invalid DVFSGovernor");
+  }
+  if (governor != GOVERNOR_NONE && interval == 0) {
+    panic("Invalid DVFSInterval");
+  }
+  if (level == 0) {
+    panic("Invalid DVFSLevel");
+  }
+  if (downThreshold >= upThreshold) {
+    panic("DVFSDownThreshold should be smaller than DVFSUpThreshold");
+  }
+}
+
+int64_t Config::readInt(uint32_t idx) {
+  int64_t ret = 0;
+
+  switch (idx) {
+    case CPU_WORK_STEALING:
+      ret = stealPolicy;
+      break;
+    case CPU_DVFS_GOVERNOR:
+      ret = governor;
+      break;
+  }
+
+  return ret;
 }
 
 uint64_t Config::readUint(uint32_t idx) {
@@ -82,6 +194,60 @@ uint64_t Config::readUint(uint32_t idx) {
     case CPU_CORE_FTL:
       ret = ftlCore;
       break;
+    case CPU_STEAL_LATENCY:
+      ret = stealLatency;
+      break;
+    case CPU_CLOCK_HIL:
+      ret = hilClock;
+      break;
+    case CPU_CLOCK_ICL:
+      ret = iclClock;
+      break;
+    case CPU_CLOCK_FTL:
+      ret = ftlClock;
+      break;
+    case CPU_DVFS_INTERVAL:
+      ret = interval;
+      break;
+    case CPU_DVFS_LEVEL:
+      ret = level;
+      break;
+    case CPU_DVFS_UP_THRESHOLD:
+      ret = upThreshold;
+      break;
+    case CPU_DVFS_DOWN_THRESHOLD:
+      ret = downThreshold;
+      break;
+  }
+
+  return ret;
+}
+
+float Config::readFloat(uint32_t idx) {
+  float ret = 0.f;
+
+  switch (idx) {
+    case CPU_DYNAMIC_POWER:
+      ret = dynamicPower;
+      break;
+    case CPU_LEAKAGE_POWER:
+      ret = leakagePower;
+      break;
+  }
+
+  return ret;
+}
+
+std::string Config::readString(uint32_t idx) {
+  std::string ret("");
+
+  switch (idx) {
+    case CPU_PROFILE_FILE:
+      ret = profileFile;
+      break;
+    case CPU_FOLDED_STACK_FILE:
+      ret = foldedStackFile;
+      break;
   }
 
   return ret;
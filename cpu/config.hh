@@ -33,8 +33,34 @@ typedef enum {
   CPU_CORE_HIL,
   CPU_CORE_ICL,
   CPU_CORE_FTL,
+  CPU_WORK_STEALING,
+  CPU_STEAL_LATENCY,
+  CPU_CLOCK_HIL,
+  CPU_CLOCK_ICL,
+  CPU_CLOCK_FTL,
+  CPU_DVFS_GOVERNOR,
+  CPU_DVFS_INTERVAL,
+  CPU_DVFS_LEVEL,
+  CPU_DVFS_UP_THRESHOLD,
+  CPU_DVFS_DOWN_THRESHOLD,
+  CPU_DYNAMIC_POWER,
+  CPU_LEAKAGE_POWER,
+  CPU_PROFILE_FILE,
+  CPU_FOLDED_STACK_FILE,
 } CPU_CONFIG;
 
+typedef enum {
+  STEAL_DISABLED,      //!< Cores only run jobs placed to them
+  STEAL_IN_LAYER,      //!< Idle core steals from cores of same layer
+  STEAL_ACROSS_LAYER,  //!< Idle core steals from cores of any layer
+} STEAL_POLICY;
+
+typedef enum {
+  GOVERNOR_NONE,         //!< All pools run at highest clock
+  GOVERNOR_UTILIZATION,  //!< Scale clock by busy ratio of cores
+  GOVERNOR_QUEUE_DEPTH,  //!< Scale clock by # queued jobs per core
+} GOVERNOR;
+
 class Config : public BaseConfig {
  private:
   uint64_t clock;    //!< Default: 400MHz
@@ -42,13 +68,34 @@ class Config : public BaseConfig {
   uint32_t iclCore;  //!< Default: 1
   uint32_t ftlCore;  //!< Default: 1
 
+  STEAL_POLICY stealPolicy;  //!< Default: STEAL_DISABLED
+  uint64_t stealLatency;     //!< Default: 100ns
+
+  uint64_t hilClock;  //!< Default: 0 (Same as clock)
+  uint64_t iclClock;  //!< Default: 0 (Same as clock)
+  uint64_t ftlClock;  //!< Default: 0 (Same as clock)
+
+  GOVERNOR governor;       //!< Default: GOVERNOR_NONE
+  uint64_t interval;       //!< Default: 100us
+  uint32_t level;          //!< Default: 4
+  uint32_t upThreshold;    //!< Default: 80%
+  uint32_t downThreshold;  //!< Default: 30%
+  float dynamicPower;      //!< Default: 40mW
+  float leakagePower;      //!< Default: 5mW
+
+  std::string profileFile;      //!< Default: ""
+  std::string foldedStackFile;  //!< Default: ""
+
  public:
   Config();
 
   bool setConfig(const char *, const char *) override;
   void update() override;
 
+  int64_t readInt(uint32_t) override;
   uint64_t readUint(uint32_t) override;
+  float readFloat(uint32_t) override;
+  std::string readString(uint32_t) override;
 };
 
 }  // namespace CPU
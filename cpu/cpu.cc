@@ -19,7 +19,8 @@
 
 #include "cpu/cpu.hh"
 
-#include <limits>
+#include <algorithm>
+#include <fstream>
 
 #include "sim/trace.hh"
 
@@ -27,6 +28,26 @@ namespace SimpleSSD {
 
 namespace CPU {
 
+const char *NAMESPACE_NAME[NAMESPACE_NUM] = {
+    "FTL", "FTL__PAGE_MAPPING", "ICL", "ICL__GENERIC_CACHE", "HIL",
+    "NVME__CONTROLLER", "NVME__PRPLIST", "NVME__SGL", "NVME__SUBSYSTEM",
+    "NVME__NAMESPACE", "NVME__OCSSD", "UFS__DEVICE", "SATA__DEVICE",
+};
+
+const char *FUNCTION_NAME[FUNCTION_NUM] = {
+    "READ", "WRITE", "FLUSH", "TRIM", "FORMAT", "READ_INTERNAL",
+    "WRITE_INTERNAL", "ERASE_INTERNAL", "TRIM_INTERNAL", "SELECT_VICTIM_BLOCK",
+    "DO_GARBAGE_COLLECTION", "CREATE_CQ", "CREATE_SQ", "COLLECT_SQ",
+    "HANDLE_REQUEST", "WORK", "COMPLETION", "GET_PRPLIST_FROM_PRP",
+    "PARSE_SGL_SEGMENT", "SUBMIT_COMMAND", "CONVERT_UNIT", "FORMAT_NVM",
+    "DATASET_MANAGEMENT", "VECTOR_CHUNK_READ", "VECTOR_CHUNK_WRITE",
+    "VECTOR_CHUNK_RESET", "PHYSICAL_PAGE_READ", "PHYSICAL_PAGE_WRITE",
+    "PHYSICAL_BLOCK_ERASE", "PROCESS_QUERY_COMMAND", "PROCESS_COMMAND",
+    "PRDT_READ", "PRDT_WRITE", "READ_DMA", "READ_NCQ", "READ_DMA_SETUP",
+    "READ_DMA_DONE", "WRITE_DMA", "WRITE_NCQ", "WRITE_DMA_SETUP",
+    "WRITE_DMA_DONE",
+};
+
 InstStat::_InstStat()
     : branch(0),
       load(0),
@@ -34,18 +55,18 @@ InstStat::_InstStat()
       arithmetic(0),
       floatingPoint(0),
       otherInsts(0),
-      latency(0) {}
+      cycles(0) {}
 
+// Each instruction takes one cycle
 InstStat::_InstStat(uint64_t b, uint64_t l, uint64_t s, uint64_t a, uint64_t f,
-                    uint64_t o, uint64_t c)
+                    uint64_t o)
     : branch(b),
       load(l),
       store(s),
       arithmetic(a),
       floatingPoint(f),
       otherInsts(o) {
-  latency = sum();
-  latency *= c;
+  cycles = sum();
 }
 
 InstStat &InstStat::operator+=(const InstStat &rhs) {
@@ -64,12 +85,124 @@ uint64_t InstStat::sum() {
   return branch + load + store + arithmetic + floatingPoint + otherInsts;
 }
 
-JobEntry::_JobEntry(DMAFunction &f, void *c, InstStat *i)
-    : func(f), context(c), inst(i) {}
+Profile::_Profile() : count(0), cycles(0), busy(0), wait(0) {}
+
+void Profile::add(uint64_t c, uint64_t b) {
+  count++;
+  cycles += c;
+  busy += b;
+}
+
+JobEntry::_JobEntry()
+    : context(nullptr),
+      inst(nullptr),
+      profile(nullptr),
+      submitAt(0),
+      delay(0),
+      latency(0),
+      prev(nullptr),
+      next(nullptr) {}
+
+CPU::CoreStat::CoreStat() : busy(0), steal(0) {}
+
+CPU::JobPool::JobPool() : freeList(nullptr) {}
+
+CPU::JobPool::~JobPool() {
+  for (auto chunk : chunks) {
+    delete[] chunk;
+  }
+}
+
+JobEntry *CPU::JobPool::allocate() {
+  if (freeList == nullptr) {
+    const uint32_t chunkSize = 64;
+    JobEntry *chunk = new JobEntry[chunkSize];
+
+    chunks.push_back(chunk);
+
+    for (uint32_t i = 0; i < chunkSize; i++) {
+      release(chunk + i);
+    }
+  }
+
+  JobEntry *job = freeList;
+
+  freeList = job->next;
+  job->next = nullptr;
+
+  return job;
+}
+
+void CPU::JobPool::release(JobEntry *job) {
+  // Destroy captures of callback now, not when entry is reused
+  job->func = nullptr;
+  job->prev = nullptr;
+  job->next = freeList;
+  freeList = job;
+}
+
+CPU::JobQueue::JobQueue() : head(nullptr), tail(nullptr), count(0) {}
+
+void CPU::JobQueue::push(JobEntry *job) {
+  job->prev = tail;
+  job->next = nullptr;
+
+  if (tail) {
+    tail->next = job;
+  }
+  else {
+    head = job;
+  }
+
+  tail = job;
+  count++;
+}
+
+JobEntry *CPU::JobQueue::front() {
+  return head;
+}
+
+JobEntry *CPU::JobQueue::back() {
+  return tail;
+}
+
+void CPU::JobQueue::popFront() {
+  JobEntry *job = head;
+
+  head = job->next;
+
+  if (head) {
+    head->prev = nullptr;
+  }
+  else {
+    tail = nullptr;
+  }
+
+  job->next = nullptr;
+  count--;
+}
+
+void CPU::JobQueue::popBack() {
+  JobEntry *job = tail;
 
-CPU::CoreStat::CoreStat() : busy(0) {}
+  tail = job->prev;
 
-CPU::Core::Core() : busy(false) {
+  if (tail) {
+    tail->next = nullptr;
+  }
+  else {
+    head = nullptr;
+  }
+
+  job->prev = nullptr;
+  count--;
+}
+
+uint64_t CPU::JobQueue::size() {
+  return count;
+}
+
+CPU::Core::Core() : busy(false), pool(nullptr), jobPool(nullptr), id(0) {
   jobEvent = allocate([this](uint64_t) { jobDone(); });
 }
 
@@ -87,27 +220,38 @@ CPU::CoreStat &CPU::Core::getStat() {
   return stat;
 }
 
-void CPU::Core::submitJob(JobEntry job, uint64_t delay) {
-  job.delay = delay;
-  job.submitAt = getTick();
+void CPU::Core::submitJob(JobEntry *job, uint64_t delay) {
+  job->delay = delay;
+  job->submitAt = getTick();
   jobs.push(job);
 
   if (!busy) {
     handleJob();
   }
+
+  pool->update(id);
+
+  // Let idle core take the job waiting behind this core
+  if (jobs.size() > 1) {
+    pool->wakeup(*this);
+  }
 }
 
 void CPU::Core::handleJob() {
-  auto &iter = jobs.front();
+  JobEntry *job = jobs.front();
   uint64_t now = getTick();
-  uint64_t diff = now - iter.submitAt;
+  uint64_t diff = now - job->submitAt;
   uint64_t finishedAt;
 
-  if (diff >= iter.delay) {
-    finishedAt = now + iter.inst->latency;
+  job->latency = pool->getLatency(*job->inst);
+
+  // Requested delay is not waiting for core
+  if (diff >= job->delay) {
+    job->profile->wait += diff - job->delay;
+    finishedAt = now + job->latency;
   }
   else {
-    finishedAt = now + iter.inst->latency + iter.delay - diff;
+    finishedAt = now + job->latency + job->delay - diff;
   }
 
   busy = true;
@@ -116,186 +260,537 @@ void CPU::Core::handleJob() {
 }
 
 void CPU::Core::jobDone() {
-  auto &iter = jobs.front();
+  JobEntry *job = jobs.front();
 
-  iter.func(getTick(), iter.context);
-  stat.busy += iter.inst->latency;
-  stat.instStat += *iter.inst;
+  job->func(getTick(), job->context);
+  stat.busy += job->latency;
+  stat.instStat += *job->inst;
+  job->profile->add(job->inst->cycles, job->latency);
 
-  jobs.pop();
+  jobs.popFront();
+  jobPool->release(job);
   busy = false;
 
   if (jobs.size() > 0) {
     handleJob();
   }
+
+  pool->update(id);
+
+  if (!busy) {
+    Core *victim = pool->findVictim();
+
+    if (victim) {
+      steal(*victim);
+    }
+  }
 }
 
-void CPU::Core::addStat(InstStat &inst) {
-  stat.busy += inst.latency;
+uint64_t CPU::Core::addStat(InstStat &inst) {
+  uint64_t latency = pool->getLatency(inst);
+
+  stat.busy += latency;
   stat.instStat += inst;
+
+  pool->update(id);
+
+  return latency;
+}
+
+void CPU::Core::setPool(CorePool *p, JobPool *j, uint32_t i) {
+  pool = p;
+  jobPool = j;
+  id = i;
+}
+
+// Move last waiting job of victim to this idle core. Like classic work
+// stealing, thief takes from the opposite end of the queue.
+void CPU::Core::steal(Core &victim) {
+  JobEntry *job = victim.jobs.back();
+  uint64_t diff = getTick() - job->submitAt;
+
+  victim.jobs.popBack();
+  victim.pool->update(victim.id);
+
+  // Account queue wait time on victim here, then keep remaining delay and
+  // pay for migration, which is not waiting for core either
+  if (diff >= job->delay) {
+    job->profile->wait += diff - job->delay;
+    job->delay = 0;
+  }
+  else {
+    job->delay -= diff;
+  }
+
+  job->delay += pool->getStealLatency();
+  job->submitAt = getTick();
+
+  stat.steal++;
+
+  jobs.push(job);
+  handleJob();
+
+  pool->update(id);
 }
 
-CPU::CPU(ConfigReader &c) : conf(c), lastResetStat(0) {
+CPU::CorePool::CorePool()
+    : stealLatency(0),
+      maxClock(0),
+      levelCount(1),
+      level(1),
+      clockPeriod(0),
+      clockChange(0),
+      dynamicPower(0.f),
+      leakagePower(0.f),
+      lastUpdate(0),
+      lastBusy(0),
+      sampledBusy(0),
+      energy(0.),
+      clockSum(0.) {}
+
+void CPU::CorePool::init(uint32_t count, JobPool *jobPool) {
+  cores.resize(count);
+  heap.resize(count);
+  position.resize(count);
+
+  for (uint32_t i = 0; i < count; i++) {
+    cores.at(i).setPool(this, jobPool, i);
+    heap.at(i) = i;
+    position.at(i) = i;
+  }
+}
+
+// Same order as linear scan: idle core with least busy ticks (lower index
+// first), then busy core with least queued jobs (higher index first)
+bool CPU::CorePool::prior(uint32_t a, uint32_t b) {
+  Core &lhs = cores[a];
+  Core &rhs = cores[b];
+
+  if (lhs.isBusy() != rhs.isBusy()) {
+    return !lhs.isBusy();
+  }
+
+  if (!lhs.isBusy()) {
+    uint64_t x = lhs.getStat().busy;
+    uint64_t y = rhs.getStat().busy;
+
+    return x < y || (x == y && a < b);
+  }
+
+  uint64_t x = lhs.getJobListSize();
+  uint64_t y = rhs.getJobListSize();
+
+  return x < y || (x == y && a > b);
+}
+
+void CPU::CorePool::swap(uint32_t i, uint32_t j) {
+  std::swap(heap[i], heap[j]);
+
+  position[heap[i]] = i;
+  position[heap[j]] = j;
+}
+
+void CPU::CorePool::siftUp(uint32_t i) {
+  while (i > 0) {
+    uint32_t parent = (i - 1) / 2;
+
+    if (!prior(heap[i], heap[parent])) {
+      break;
+    }
+
+    swap(i, parent);
+    i = parent;
+  }
+}
+
+void CPU::CorePool::siftDown(uint32_t i) {
+  uint32_t size = heap.size();
+
+  while (true) {
+    uint32_t best = i;
+    uint32_t left = i * 2 + 1;
+    uint32_t right = left + 1;
+
+    if (left < size && prior(heap[left], heap[best])) {
+      best = left;
+    }
+    if (right < size && prior(heap[right], heap[best])) {
+      best = right;
+    }
+    if (best == i) {
+      break;
+    }
+
+    swap(i, best);
+    i = best;
+  }
+}
+
+void CPU::CorePool::update(uint32_t idx) {
+  siftUp(position[idx]);
+  siftDown(position[idx]);
+}
+
+CPU::Core &CPU::CorePool::select() {
+  return cores[heap.front()];
+}
+
+void CPU::CorePool::resetStat() {
+  for (auto &core : cores) {
+    auto &stat = core.getStat();
+
+    stat.busy = 0;
+    stat.steal = 0;
+    stat.instStat = InstStat();
+  }
+
+  lastUpdate = getTick();
+  lastBusy = 0;
+  sampledBusy = 0;
+  energy = 0.;
+  clockSum = 0.;
+  clockChange = 0;
+
+  // Busy ticks of all cores are changed, rebuild heap
+  for (uint32_t i = heap.size() / 2; i-- > 0;) {
+    siftDown(i);
+  }
+}
+
+void CPU::CorePool::setSteal(std::vector<CorePool *> &list, uint64_t latency) {
+  siblings = list;
+  stealLatency = latency;
+}
+
+uint64_t CPU::CorePool::getStealLatency() {
+  return stealLatency;
+}
+
+// Find core with most waiting jobs, searching own pool first
+CPU::Core *CPU::CorePool::findVictim() {
+  Core *victim = nullptr;
+  uint64_t most = 1;  // Front job is running
+
+  for (auto pool : siblings) {
+    for (auto &core : pool->cores) {
+      if (core.getJobListSize() > most) {
+        most = core.getJobListSize();
+        victim = &core;
+      }
+    }
+
+    if (victim) {
+      break;
+    }
+  }
+
+  return victim;
+}
+
+// Give waiting job of busy core to idle core, if any
+void CPU::CorePool::wakeup(Core &victim) {
+  for (auto pool : siblings) {
+    Core &core = pool->select();
+
+    if (!core.isBusy()) {
+      core.steal(victim);
+
+      break;
+    }
+  }
+}
+
+void CPU::CorePool::setDVFS(uint64_t clock, uint32_t levels, float dynamic,
+                            float leakage) {
+  maxClock = clock;
+  levelCount = levels;
+  dynamicPower = dynamic;
+  leakagePower = leakage;
+  lastUpdate = getTick();
+
+  level = levelCount;
+  clockPeriod = 1000000000000. / getClock();
+}
+
+uint64_t CPU::CorePool::getLatency(InstStat &inst) {
+  return inst.cycles * clockPeriod;
+}
+
+uint64_t CPU::CorePool::getMaxClock() {
+  return maxClock;
+}
+
+uint64_t CPU::CorePool::getClock() {
+  return maxClock * level / levelCount;
+}
+
+uint32_t CPU::CorePool::getLevel() {
+  return level;
+}
+
+// Running jobs keep their latency, new clock applies to next jobs
+void CPU::CorePool::setLevel(uint32_t newLevel) {
+  updateEnergy();
+
+  level = newLevel;
+  clockPeriod = 1000000000000. / getClock();
+  clockChange++;
+}
+
+uint64_t CPU::CorePool::getBusy() {
+  uint64_t busy = 0;
+
+  for (auto &core : cores) {
+    busy += core.getStat().busy;
+  }
+
+  return busy;
+}
+
+// Return load of this pool in percent
+uint64_t CPU::CorePool::getLoad(GOVERNOR governor, uint64_t interval) {
+  uint64_t load = 0;
+
+  if (governor == GOVERNOR_UTILIZATION) {
+    uint64_t busy = getBusy();
+
+    load = (busy - sampledBusy) * 100 / (interval * cores.size());
+    sampledBusy = busy;
+  }
+  else if (governor == GOVERNOR_QUEUE_DEPTH) {
+    for (auto &core : cores) {
+      load += core.getJobListSize();
+    }
+
+    load = load * 100 / cores.size();
+  }
+
+  return load;
+}
+
+// Integrate power since last update, voltage is assumed to scale with clock
+void CPU::CorePool::updateEnergy() {
+  uint64_t now = getTick();
+  uint64_t busy = getBusy();
+  double scale = (double)level / levelCount;
+
+  // [mW] * [ps] / 1000 = [pJ]
+  energy += dynamicPower * scale * scale * scale * (busy - lastBusy) / 1000.;
+  energy += leakagePower * scale * (now - lastUpdate) * cores.size() / 1000.;
+  clockSum += getClock() / 1000000. * (now - lastUpdate);
+
+  lastUpdate = now;
+  lastBusy = busy;
+}
+
+double CPU::CorePool::getEnergy() {
+  return energy;
+}
+
+double CPU::CorePool::getAverageClock(uint64_t since) {
+  uint64_t elapsed = lastUpdate - since;
+
+  return elapsed > 0 ? clockSum / elapsed : getClock() / 1000000.;
+}
+
+uint64_t CPU::CorePool::getClockChange() {
+  return clockChange;
+}
+
+uint32_t CPU::CorePool::size() {
+  return cores.size();
+}
+
+CPU::Core &CPU::CorePool::at(uint32_t idx) {
+  return cores.at(idx);
+}
+
+std::vector<CPU::Core>::iterator CPU::CorePool::begin() {
+  return cores.begin();
+}
+
+std::vector<CPU::Core>::iterator CPU::CorePool::end() {
+  return cores.end();
+}
+
+CPU::CPU(ConfigReader &c) : conf(c), lastResetStat(0), cpiDefined() {
   clockSpeed = conf.readUint(CONFIG_CPU, CPU_CLOCK);
   clockPeriod = 1000000000000. / clockSpeed;  // in pico-seconds
 
-  hilCore.resize(conf.readUint(CONFIG_CPU, CPU_CORE_HIL));
-  iclCore.resize(conf.readUint(CONFIG_CPU, CPU_CORE_ICL));
-  ftlCore.resize(conf.readUint(CONFIG_CPU, CPU_CORE_FTL));
-
-  // Initialize CPU table
-  cpi.insert({FTL, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({FTL__PAGE_MAPPING, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({ICL, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({ICL__GENERIC_CACHE, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({HIL, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__CONTROLLER, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__PRPLIST, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__SGL, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__SUBSYSTEM, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__NAMESPACE, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({NVME__OCSSD, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({UFS__DEVICE, std::unordered_map<uint16_t, InstStat>()});
-  cpi.insert({SATA__DEVICE, std::unordered_map<uint16_t, InstStat>()});
+  hilCore.init(conf.readUint(CONFIG_CPU, CPU_CORE_HIL), &jobPool);
+  iclCore.init(conf.readUint(CONFIG_CPU, CPU_CORE_ICL), &jobPool);
+  ftlCore.init(conf.readUint(CONFIG_CPU, CPU_CORE_FTL), &jobPool);
+
+  // DVFS
+  governor = (GOVERNOR)conf.readInt(CONFIG_CPU, CPU_DVFS_GOVERNOR);
+  dvfsInterval = conf.readUint(CONFIG_CPU, CPU_DVFS_INTERVAL);
+  dvfsLevel = conf.readUint(CONFIG_CPU, CPU_DVFS_LEVEL);
+  upThreshold = conf.readUint(CONFIG_CPU, CPU_DVFS_UP_THRESHOLD);
+  downThreshold = conf.readUint(CONFIG_CPU, CPU_DVFS_DOWN_THRESHOLD);
+
+  float dynamicPower = conf.readFloat(CONFIG_CPU, CPU_DYNAMIC_POWER);
+  float leakagePower = conf.readFloat(CONFIG_CPU, CPU_LEAKAGE_POWER);
+
+  hilCore.setDVFS(conf.readUint(CONFIG_CPU, CPU_CLOCK_HIL), dvfsLevel,
+                  dynamicPower, leakagePower);
+  iclCore.setDVFS(conf.readUint(CONFIG_CPU, CPU_CLOCK_ICL), dvfsLevel,
+                  dynamicPower, leakagePower);
+  ftlCore.setDVFS(conf.readUint(CONFIG_CPU, CPU_CLOCK_FTL), dvfsLevel,
+                  dynamicPower, leakagePower);
+
+  if (governor != GOVERNOR_NONE) {
+    dvfsEvent = allocate([this](uint64_t now) { scaleClock(now); });
+
+    schedule(dvfsEvent, getTick() + dvfsInterval);
+  }
+
+  // Map namespace to core pool
+  for (uint16_t ns = 0; ns < NAMESPACE_NUM; ns++) {
+    CorePool *pool = nullptr;
+
+    switch (ns) {
+      case FTL:
+      case FTL__PAGE_MAPPING:
+        pool = &ftlCore;
+        layerName[ns] = "FTL";
+
+        break;
+      case ICL:
+      case ICL__GENERIC_CACHE:
+        pool = &iclCore;
+        layerName[ns] = "ICL";
+
+        break;
+      case HIL:
+      case NVME__CONTROLLER:
+      case NVME__PRPLIST:
+      case NVME__SGL:
+      case NVME__SUBSYSTEM:
+      case NVME__NAMESPACE:
+      case NVME__OCSSD:
+      case UFS__DEVICE:
+      case SATA__DEVICE:
+        pool = &hilCore;
+        layerName[ns] = "HIL";
+
+        break;
+      default:
+        panic("Undefined function namespace %u", ns);
+
+        break;
+    }
+
+    corePool[ns] = pool->size() > 0 ? pool : nullptr;
+  }
+
+  // Work stealing
+  STEAL_POLICY policy =
+      (STEAL_POLICY)conf.readInt(CONFIG_CPU, CPU_WORK_STEALING);
+
+  if (policy != STEAL_DISABLED) {
+    CorePool *pools[] = {&hilCore, &iclCore, &ftlCore};
+    uint64_t latency = conf.readUint(CONFIG_CPU, CPU_STEAL_LATENCY);
+
+    for (auto pool : pools) {
+      std::vector<CorePool *> siblings;
+
+      siblings.push_back(pool);
+
+      if (policy == STEAL_ACROSS_LAYER) {
+        for (auto other : pools) {
+          if (other != pool && other->size() > 0) {
+            siblings.push_back(other);
+          }
+        }
+      }
+
+      pool->setSteal(siblings, latency);
+    }
+  }
 
   // Insert item (Use cpu/generator/generate.py to generate this code)
-  cpi.find(0)->second.insert({0, InstStat(5, 32, 6, 13, 0, 1, clockPeriod)});
-  cpi.find(0)->second.insert({1, InstStat(5, 32, 6, 13, 0, 1, clockPeriod)});
-  cpi.find(0)->second.insert({3, InstStat(5, 32, 6, 13, 0, 1, clockPeriod)});
-  cpi.find(0)->second.insert({4, InstStat(4, 24, 4, 6, 0, 0, clockPeriod)});
-  cpi.find(1)->second.insert({0, InstStat(8, 28, 7, 18, 0, 1, clockPeriod)});
-  cpi.find(1)->second.insert({1, InstStat(8, 28, 7, 19, 0, 0, clockPeriod)});
-  cpi.find(1)->second.insert({3, InstStat(4, 28, 6, 11, 0, 0, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {4, InstStat(63, 180, 21, 147, 0, 2, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {9, InstStat(177, 504, 113, 415, 118, 19, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {10, InstStat(157, 616, 102, 338, 0, 2, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {5, InstStat(45, 180, 15, 155, 0, 0, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {6, InstStat(133, 452, 54, 377, 91, 1, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {8, InstStat(34, 140, 10, 146, 0, 0, clockPeriod)});
-  cpi.find(1)->second.insert(
-      {7, InstStat(120, 236, 86, 260, 0, 1, clockPeriod)});
-  cpi.find(2)->second.insert({0, InstStat(8, 88, 17, 27, 0, 1, clockPeriod)});
-  cpi.find(2)->second.insert({1, InstStat(8, 88, 17, 27, 0, 1, clockPeriod)});
-  cpi.find(2)->second.insert({2, InstStat(5, 40, 6, 12, 0, 0, clockPeriod)});
-  cpi.find(2)->second.insert({3, InstStat(5, 40, 6, 12, 0, 0, clockPeriod)});
-  cpi.find(2)->second.insert({4, InstStat(5, 40, 6, 12, 0, 0, clockPeriod)});
-  cpi.find(3)->second.insert(
-      {0, InstStat(90, 532, 64, 284, 0, 1, clockPeriod)});
-  cpi.find(3)->second.insert(
-      {1, InstStat(82, 496, 53, 312, 0, 5, clockPeriod)});
-  cpi.find(3)->second.insert({2, InstStat(22, 120, 20, 59, 0, 2, clockPeriod)});
-  cpi.find(3)->second.insert({3, InstStat(22, 120, 20, 61, 0, 2, clockPeriod)});
-  cpi.find(3)->second.insert({4, InstStat(9, 72, 12, 86, 0, 1, clockPeriod)});
-  cpi.find(4)->second.insert(
-      {0, InstStat(61, 312, 102, 120, 0, 2, clockPeriod)});
-  cpi.find(4)->second.insert(
-      {1, InstStat(61, 312, 102, 120, 0, 2, clockPeriod)});
-  cpi.find(4)->second.insert({2, InstStat(27, 100, 27, 49, 0, 1, clockPeriod)});
-  cpi.find(5)->second.insert(
-      {14, InstStat(44, 164, 32, 68, 0, 2, clockPeriod)});
-  cpi.find(5)->second.insert({13, InstStat(0, 0, 0, 0, 0, 0, clockPeriod)});
-  cpi.find(5)->second.insert(
-      {16, InstStat(136, 360, 65, 230, 0, 3, clockPeriod)});
-  cpi.find(5)->second.insert(
-      {15, InstStat(54, 140, 36, 91, 0, 8, clockPeriod)});
-  cpi.find(5)->second.insert({11, InstStat(0, 0, 0, 0, 0, 0, clockPeriod)});
-  cpi.find(5)->second.insert({12, InstStat(0, 0, 0, 0, 0, 0, clockPeriod)});
-  cpi.find(6)->second.insert(
-      {17, InstStat(41, 168, 42, 75, 0, 1, clockPeriod)});
-  cpi.find(6)->second.insert(
-      {0, InstStat(99, 456, 94, 177, 0, 6, clockPeriod)});
-  cpi.find(6)->second.insert(
-      {1, InstStat(99, 456, 94, 177, 0, 6, clockPeriod)});
-  cpi.find(7)->second.insert(
-      {18, InstStat(44, 152, 35, 78, 0, 2, clockPeriod)});
-  cpi.find(7)->second.insert(
-      {0, InstStat(99, 456, 94, 177, 0, 6, clockPeriod)});
-  cpi.find(7)->second.insert(
-      {1, InstStat(99, 456, 94, 177, 0, 6, clockPeriod)});
-  cpi.find(8)->second.insert(
-      {19, InstStat(119, 220, 45, 160, 0, 6, clockPeriod)});
-  cpi.find(8)->second.insert({20, InstStat(4, 40, 14, 110, 0, 1, clockPeriod)});
-  cpi.find(8)->second.insert(
-      {21, InstStat(70, 200, 42, 161, 0, 1, clockPeriod)});
-  cpi.find(9)->second.insert({19, InstStat(27, 44, 5, 37, 0, 0, clockPeriod)});
-  cpi.find(9)->second.insert(
-      {0, InstStat(82, 292, 42, 128, 0, 4, clockPeriod)});
-  cpi.find(9)->second.insert(
-      {1, InstStat(86, 304, 47, 141, 0, 3, clockPeriod)});
-  cpi.find(9)->second.insert({2, InstStat(51, 124, 28, 78, 0, 3, clockPeriod)});
-  cpi.find(9)->second.insert(
-      {22, InstStat(131, 364, 71, 200, 0, 7, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {19, InstStat(155, 100, 12, 208, 0, 4, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {0, InstStat(93, 284, 60, 146, 0, 5, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {1, InstStat(95, 276, 60, 150, 0, 4, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {22, InstStat(119, 328, 76, 186, 0, 4, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {5, InstStat(54, 172, 69, 89, 0, 1, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {6, InstStat(72, 236, 77, 141, 0, 3, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {7, InstStat(68, 204, 77, 116, 0, 1, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {20, InstStat(65, 388, 63, 303, 0, 1, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {23, InstStat(128, 368, 76, 204, 0, 4, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {24, InstStat(128, 384, 81, 209, 0, 6, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {25, InstStat(69, 184, 43, 112, 0, 4, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {26, InstStat(206, 692, 157, 315, 0, 5, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {27, InstStat(183, 620, 154, 284, 0, 6, clockPeriod)});
-  cpi.find(10)->second.insert(
-      {28, InstStat(162, 460, 78, 227, 0, 4, clockPeriod)});
-  cpi.find(11)->second.insert(
-      {29, InstStat(51, 132, 40, 97, 0, 0, clockPeriod)});
-  cpi.find(11)->second.insert(
-      {30, InstStat(212, 460, 117, 491, 0, 9, clockPeriod)});
-  cpi.find(11)->second.insert(
-      {31, InstStat(42, 172, 43, 74, 0, 2, clockPeriod)});
-  cpi.find(11)->second.insert(
-      {32, InstStat(42, 172, 43, 74, 0, 2, clockPeriod)});
-  cpi.find(11)->second.insert({0, InstStat(29, 76, 17, 51, 0, 2, clockPeriod)});
-  cpi.find(11)->second.insert({1, InstStat(29, 76, 17, 51, 0, 2, clockPeriod)});
-  cpi.find(11)->second.insert({2, InstStat(25, 64, 18, 44, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {19, InstStat(157, 352, 69, 178, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {31, InstStat(42, 172, 43, 73, 0, 3, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {32, InstStat(42, 172, 43, 73, 0, 3, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {0, InstStat(28, 84, 23, 119, 0, 0, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {1, InstStat(28, 84, 23, 120, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert({2, InstStat(25, 64, 18, 44, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {33, InstStat(57, 212, 36, 128, 0, 3, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {34, InstStat(34, 116, 29, 72, 0, 3, clockPeriod)});
-  cpi.find(12)->second.insert({35, InstStat(16, 64, 9, 38, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {36, InstStat(28, 72, 15, 48, 0, 2, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {37, InstStat(57, 212, 36, 127, 0, 3, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {38, InstStat(34, 128, 31, 68, 0, 2, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {39, InstStat(18, 56, 10, 37, 0, 1, clockPeriod)});
-  cpi.find(12)->second.insert(
-      {40, InstStat(33, 100, 17, 61, 0, 3, clockPeriod)});
+  setCPI(0, 0, InstStat(5, 32, 6, 13, 0, 1));
+  setCPI(0, 1, InstStat(5, 32, 6, 13, 0, 1));
+  setCPI(0, 3, InstStat(5, 32, 6, 13, 0, 1));
+  setCPI(0, 4, InstStat(4, 24, 4, 6, 0, 0));
+  setCPI(1, 0, InstStat(8, 28, 7, 18, 0, 1));
+  setCPI(1, 1, InstStat(8, 28, 7, 19, 0, 0));
+  setCPI(1, 3, InstStat(4, 28, 6, 11, 0, 0));
+  setCPI(1, 4, InstStat(63, 180, 21, 147, 0, 2));
+  setCPI(1, 9, InstStat(177, 504, 113, 415, 118, 19));
+  setCPI(1, 10, InstStat(157, 616, 102, 338, 0, 2));
+  setCPI(1, 5, InstStat(45, 180, 15, 155, 0, 0));
+  setCPI(1, 6, InstStat(133, 452, 54, 377, 91, 1));
+  setCPI(1, 8, InstStat(34, 140, 10, 146, 0, 0));
+  setCPI(1, 7, InstStat(120, 236, 86, 260, 0, 1));
+  setCPI(2, 0, InstStat(8, 88, 17, 27, 0, 1));
+  setCPI(2, 1, InstStat(8, 88, 17, 27, 0, 1));
+  setCPI(2, 2, InstStat(5, 40, 6, 12, 0, 0));
+  setCPI(2, 3, InstStat(5, 40, 6, 12, 0, 0));
+  setCPI(2, 4, InstStat(5, 40, 6, 12, 0, 0));
+  setCPI(3, 0, InstStat(90, 532, 64, 284, 0, 1));
+  setCPI(3, 1, InstStat(82, 496, 53, 312, 0, 5));
+  setCPI(3, 2, InstStat(22, 120, 20, 59, 0, 2));
+  setCPI(3, 3, InstStat(22, 120, 20, 61, 0, 2));
+  setCPI(3, 4, InstStat(9, 72, 12, 86, 0, 1));
+  setCPI(4, 0, InstStat(61, 312, 102, 120, 0, 2));
+  setCPI(4, 1, InstStat(61, 312, 102, 120, 0, 2));
+  setCPI(4, 2, InstStat(27, 100, 27, 49, 0, 1));
+  setCPI(5, 14, InstStat(44, 164, 32, 68, 0, 2));
+  setCPI(5, 13, InstStat(0, 0, 0, 0, 0, 0));
+  setCPI(5, 16, InstStat(136, 360, 65, 230, 0, 3));
+  setCPI(5, 15, InstStat(54, 140, 36, 91, 0, 8));
+  setCPI(5, 11, InstStat(0, 0, 0, 0, 0, 0));
+  setCPI(5, 12, InstStat(0, 0, 0, 0, 0, 0));
+  setCPI(6, 17, InstStat(41, 168, 42, 75, 0, 1));
+  setCPI(6, 0, InstStat(99, 456, 94, 177, 0, 6));
+  setCPI(6, 1, InstStat(99, 456, 94, 177, 0, 6));
+  setCPI(7, 18, InstStat(44, 152, 35, 78, 0, 2));
+  setCPI(7, 0, InstStat(99, 456, 94, 177, 0, 6));
+  setCPI(7, 1, InstStat(99, 456, 94, 177, 0, 6));
+  setCPI(8, 19, InstStat(119, 220, 45, 160, 0, 6));
+  setCPI(8, 20, InstStat(4, 40, 14, 110, 0, 1));
+  setCPI(8, 21, InstStat(70, 200, 42, 161, 0, 1));
+  setCPI(9, 19, InstStat(27, 44, 5, 37, 0, 0));
+  setCPI(9, 0, InstStat(82, 292, 42, 128, 0, 4));
+  setCPI(9, 1, InstStat(86, 304, 47, 141, 0, 3));
+  setCPI(9, 2, InstStat(51, 124, 28, 78, 0, 3));
+  setCPI(9, 22, InstStat(131, 364, 71, 200, 0, 7));
+  setCPI(10, 19, InstStat(155, 100, 12, 208, 0, 4));
+  setCPI(10, 0, InstStat(93, 284, 60, 146, 0, 5));
+  setCPI(10, 1, InstStat(95, 276, 60, 150, 0, 4));
+  setCPI(10, 22, InstStat(119, 328, 76, 186, 0, 4));
+  setCPI(10, 5, InstStat(54, 172, 69, 89, 0, 1));
+  setCPI(10, 6, InstStat(72, 236, 77, 141, 0, 3));
+  setCPI(10, 7, InstStat(68, 204, 77, 116, 0, 1));
+  setCPI(10, 20, InstStat(65, 388, 63, 303, 0, 1));
+  setCPI(10, 23, InstStat(128, 368, 76, 204, 0, 4));
+  setCPI(10, 24, InstStat(128, 384, 81, 209, 0, 6));
+  setCPI(10, 25, InstStat(69, 184, 43, 112, 0, 4));
+  setCPI(10, 26, InstStat(206, 692, 157, 315, 0, 5));
+  setCPI(10, 27, InstStat(183, 620, 154, 284, 0, 6));
+  setCPI(10, 28, InstStat(162, 460, 78, 227, 0, 4));
+  setCPI(11, 29, InstStat(51, 132, 40, 97, 0, 0));
+  setCPI(11, 30, InstStat(212, 460, 117, 491, 0, 9));
+  setCPI(11, 31, InstStat(42, 172, 43, 74, 0, 2));
+  setCPI(11, 32, InstStat(42, 172, 43, 74, 0, 2));
+  setCPI(11, 0, InstStat(29, 76, 17, 51, 0, 2));
+  setCPI(11, 1, InstStat(29, 76, 17, 51, 0, 2));
+  setCPI(11, 2, InstStat(25, 64, 18, 44, 0, 1));
+  setCPI(12, 19, InstStat(157, 352, 69, 178, 0, 1));
+  setCPI(12, 31, InstStat(42, 172, 43, 73, 0, 3));
+  setCPI(12, 32, InstStat(42, 172, 43, 73, 0, 3));
+  setCPI(12, 0, InstStat(28, 84, 23, 119, 0, 0));
+  setCPI(12, 1, InstStat(28, 84, 23, 120, 0, 1));
+  setCPI(12, 2, InstStat(25, 64, 18, 44, 0, 1));
+  setCPI(12, 33, InstStat(57, 212, 36, 128, 0, 3));
+  setCPI(12, 34, InstStat(34, 116, 29, 72, 0, 3));
+  setCPI(12, 35, InstStat(16, 64, 9, 38, 0, 1));
+  setCPI(12, 36, InstStat(28, 72, 15, 48, 0, 2));
+  setCPI(12, 37, InstStat(57, 212, 36, 127, 0, 3));
+  setCPI(12, 38, InstStat(34, 128, 31, 68, 0, 2));
+  setCPI(12, 39, InstStat(18, 56, 10, 37, 0, 1));
+  setCPI(12, 40, InstStat(33, 100, 17, 61, 0, 3));
 }
 
 CPU::~CPU() {}
@@ -303,7 +798,8 @@ CPU::~CPU() {}
 void CPU::calculatePower(Power &power) {
   // Print stats before die
   ParseXML param;
-  uint64_t simCycle = (getTick() - lastResetStat) / clockPeriod;
+  uint64_t simTick = getTick() - lastResetStat;
+  uint64_t simCycle = simTick / clockPeriod;
   uint32_t totalCore = hilCore.size() + iclCore.size() + ftlCore.size();
   uint32_t coreIdx = 0;
 
@@ -343,9 +839,19 @@ void CPU::calculatePower(Power &power) {
 
   // Now, we are using heterogeneous cores
   for (coreIdx = 0; coreIdx < totalCore; coreIdx++) {
+    // Highest clock of layer which this core belongs to
+    uint64_t coreClock = ftlCore.getMaxClock();
+
+    if (coreIdx < hilCore.size()) {
+      coreClock = hilCore.getMaxClock();
+    }
+    else if (coreIdx < hilCore.size() + iclCore.size()) {
+      coreClock = iclCore.getMaxClock();
+    }
+
     // system.core
     {
-      param.sys.core[coreIdx].clock_rate = param.sys.target_core_clockrate;
+      param.sys.core[coreIdx].clock_rate = coreClock / 1000000;
       param.sys.core[coreIdx].opt_local = 0;
       param.sys.core[coreIdx].instruction_length = 32;
       param.sys.core[coreIdx].opcode_width = 7;
@@ -475,7 +981,7 @@ void CPU::calculatePower(Power &power) {
     param.sys.core[coreIdx].branch_instructions = stat.instStat.branch;
     param.sys.core[coreIdx].load_instructions = stat.instStat.load;
     param.sys.core[coreIdx].store_instructions = stat.instStat.store;
-    param.sys.core[coreIdx].busy_cycles = stat.busy / clockPeriod;
+    param.sys.core[coreIdx].busy_cycles = stat.instStat.sum();
 
     coreIdx++;
   }
@@ -489,7 +995,7 @@ void CPU::calculatePower(Power &power) {
     param.sys.core[coreIdx].branch_instructions = stat.instStat.branch;
     param.sys.core[coreIdx].load_instructions = stat.instStat.load;
     param.sys.core[coreIdx].store_instructions = stat.instStat.store;
-    param.sys.core[coreIdx].busy_cycles = stat.busy / clockPeriod;
+    param.sys.core[coreIdx].busy_cycles = stat.instStat.sum();
 
     coreIdx++;
   }
@@ -503,15 +1009,32 @@ void CPU::calculatePower(Power &power) {
     param.sys.core[coreIdx].branch_instructions = stat.instStat.branch;
     param.sys.core[coreIdx].load_instructions = stat.instStat.load;
     param.sys.core[coreIdx].store_instructions = stat.instStat.store;
-    param.sys.core[coreIdx].busy_cycles = stat.busy / clockPeriod;
+    param.sys.core[coreIdx].busy_cycles = stat.instStat.sum();
 
     coreIdx++;
   };
 
   for (coreIdx = 0; coreIdx < totalCore; coreIdx++) {
-    param.sys.core[coreIdx].total_cycles = simCycle;
-    param.sys.core[coreIdx].idle_cycles =
-        simCycle - param.sys.core[coreIdx].busy_cycles;
+    // Core runs on clock of its layer. Each busy cycle takes at least one
+    // period of the highest clock of the layer.
+    CorePool *pool = &ftlCore;
+
+    if (coreIdx < hilCore.size()) {
+      pool = &hilCore;
+    }
+    else if (coreIdx < hilCore.size() + iclCore.size()) {
+      pool = &iclCore;
+    }
+
+    uint64_t busyCycle = param.sys.core[coreIdx].busy_cycles;
+    uint64_t totalCycle = (uint64_t)(simTick * (pool->getMaxClock() / 1e12));
+
+    if (totalCycle < busyCycle) {
+      totalCycle = busyCycle;
+    }
+
+    param.sys.core[coreIdx].total_cycles = totalCycle;
+    param.sys.core[coreIdx].idle_cycles = totalCycle - busyCycle;
     param.sys.core[coreIdx].committed_instructions =
         param.sys.core[coreIdx].total_instructions;
     param.sys.core[coreIdx].committed_int_instructions =
@@ -638,155 +1161,104 @@ void CPU::calculatePower(Power &power) {
   mcpat.getPower(power);
 }
 
-uint32_t CPU::leastBusyCPU(std::vector<Core> &list) {
-  uint32_t idx = list.size();
-  uint64_t busymin = std::numeric_limits<uint64_t>::max();
+void CPU::setCPI(uint16_t ns, uint16_t fct, InstStat inst) {
+  cpi[ns][fct] = inst;
+  cpiDefined[ns][fct] = true;
+}
 
-  for (uint32_t i = 0; i < list.size(); i++) {
-    auto &core = list.at(i);
-    auto busy = core.getStat().busy;
+InstStat *CPU::getCPI(NAMESPACE ns, FUNCTION fct) {
+  if (fct >= FUNCTION_NUM || !cpiDefined[ns][fct]) {
+    panic("Namespace %u does not have function %u", ns, fct);
+  }
 
-    if (!core.isBusy() && busy < busymin) {
-      busymin = busy;
-      idx = i;
-    }
+  return &cpi[ns][fct];
+}
+
+CPU::Core *CPU::selectCore(NAMESPACE ns) {
+  if (ns >= NAMESPACE_NUM) {
+    panic("Undefined function namespace %u", ns);
   }
 
-  if (idx == list.size()) {
-    uint64_t jobmin = std::numeric_limits<uint64_t>::max();
+  CorePool *pool = corePool[ns];
 
-    for (uint32_t i = 0; i < list.size(); i++) {
-      auto jobs = list.at(i).getJobListSize();
+  return pool ? &pool->select() : nullptr;
+}
 
-      if (jobs <= jobmin) {
-        jobmin = jobs;
-        idx = i;
-      }
+void CPU::scaleClock(uint64_t now) {
+  CorePool *pools[] = {&hilCore, &iclCore, &ftlCore};
+
+  for (auto pool : pools) {
+    if (pool->size() == 0) {
+      continue;
+    }
+
+    uint64_t load = pool->getLoad(governor, dvfsInterval);
+    uint32_t level = pool->getLevel();
+
+    if (load > upThreshold && level < dvfsLevel) {
+      pool->setLevel(level + 1);
+    }
+    else if (load < downThreshold && level > 1) {
+      pool->setLevel(level - 1);
     }
   }
 
-  return idx;
+  schedule(dvfsEvent, now + dvfsInterval);
 }
 
-void CPU::execute(NAMESPACE ns, FUNCTION fct, DMAFunction &func, void *context,
-                  uint64_t delay) {
-  Core *pCore = nullptr;
-
-  // Find dedicated core
-  switch (ns) {
-    case FTL:
-    case FTL__PAGE_MAPPING:
-      if (ftlCore.size() > 0) {
-        pCore = &ftlCore.at(leastBusyCPU(ftlCore));
-      }
-
-      break;
-    case ICL:
-    case ICL__GENERIC_CACHE:
-      if (iclCore.size() > 0) {
-        pCore = &iclCore.at(leastBusyCPU(iclCore));
-      }
+JobEntry *CPU::allocateJob(NAMESPACE ns, FUNCTION fct, void *context) {
+  JobEntry *job = jobPool.allocate();
 
-      break;
-    case HIL:
-    case NVME__CONTROLLER:
-    case NVME__PRPLIST:
-    case NVME__SGL:
-    case NVME__SUBSYSTEM:
-    case NVME__NAMESPACE:
-    case NVME__OCSSD:
-    case UFS__DEVICE:
-    case SATA__DEVICE:
-      if (hilCore.size() > 0) {
-        pCore = &hilCore.at(leastBusyCPU(hilCore));
-      }
+  job->context = context;
+  job->inst = getCPI(ns, fct);
+  job->profile = &profile[ns][fct];
 
-      break;
-    default:
-      panic("Undefined function namespace %u", ns);
+  return job;
+}
 
-      break;
-  }
+void CPU::execute(NAMESPACE ns, FUNCTION fct, DMAFunction &func, void *context,
+                  uint64_t delay) {
+  Core *pCore = selectCore(ns);
 
   if (pCore) {
-    // Get CPI table
-    auto table = cpi.find(ns);
-
-    if (table == cpi.end()) {
-      panic("Namespace %u not defined in CPI table", ns);
-    }
-
-    // Get CPI
-    auto inst = table->second.find(fct);
+    JobEntry *job = allocateJob(ns, fct, context);
 
-    if (inst == table->second.end()) {
-      panic("Namespace %u does not have function %u", ns, fct);
-    }
+    job->func = func;
 
-    pCore->submitJob(JobEntry(func, context, &inst->second), delay);
+    pCore->submitJob(job, delay);
   }
   else {
     func(getTick(), context);
   }
 }
 
-uint64_t CPU::applyLatency(NAMESPACE ns, FUNCTION fct) {
-  Core *pCore = nullptr;
-
-  // Find dedicated core
-  switch (ns) {
-    case FTL:
-    case FTL__PAGE_MAPPING:
-      if (ftlCore.size() > 0) {
-        pCore = &ftlCore.at(leastBusyCPU(ftlCore));
-      }
-
-      break;
-    case ICL:
-    case ICL__GENERIC_CACHE:
-      if (iclCore.size() > 0) {
-        pCore = &iclCore.at(leastBusyCPU(iclCore));
-      }
+// Same as above, but callback is moved into job instead of copied
+void CPU::execute(NAMESPACE ns, FUNCTION fct, DMAFunction &&func,
+                  void *context, uint64_t delay) {
+  Core *pCore = selectCore(ns);
 
-      break;
-    case HIL:
-    case NVME__CONTROLLER:
-    case NVME__PRPLIST:
-    case NVME__SGL:
-    case NVME__SUBSYSTEM:
-    case NVME__NAMESPACE:
-    case NVME__OCSSD:
-    case UFS__DEVICE:
-    case SATA__DEVICE:
-      if (hilCore.size() > 0) {
-        pCore = &hilCore.at(leastBusyCPU(hilCore));
-      }
+  if (pCore) {
+    JobEntry *job = allocateJob(ns, fct, context);
 
-      break;
-    default:
-      panic("Undefined function namespace %u", ns);
+    job->func = std::move(func);
 
-      break;
+    pCore->submitJob(job, delay);
   }
+  else {
+    func(getTick(), context);
+  }
+}
 
-  if (pCore) {
-    // Get CPI table
-    auto table = cpi.find(ns);
-
-    if (table == cpi.end()) {
-      panic("Namespace %u not defined in CPI table", ns);
-    }
-
-    // Get CPI
-    auto inst = table->second.find(fct);
+uint64_t CPU::applyLatency(NAMESPACE ns, FUNCTION fct) {
+  Core *pCore = selectCore(ns);
 
-    if (inst == table->second.end()) {
-      panic("Namespace %u does not have function %u", ns, fct);
-    }
+  if (pCore) {
+    InstStat *inst = getCPI(ns, fct);
+    uint64_t latency = pCore->addStat(*inst);
 
-    pCore->addStat(inst->second);
+    profile[ns][fct].add(inst->cycles, latency);
 
-    return inst->second.latency;
+    return latency;
   }
 
   return 0;
@@ -828,6 +1300,10 @@ void CPU::getStatList(std::vector<Stats> &list, std::string prefix) {
     temp.name = prefix + ".hil" + number + ".insts.others";
     temp.desc = "CPU for HIL core " + number + " executed other instructions";
     list.push_back(temp);
+
+    temp.name = prefix + ".hil" + number + ".steal";
+    temp.desc = "CPU for HIL core " + number + " stolen jobs";
+    list.push_back(temp);
   }
 
   for (uint32_t i = 0; i < iclCore.size(); i++) {
@@ -862,6 +1338,10 @@ void CPU::getStatList(std::vector<Stats> &list, std::string prefix) {
     temp.name = prefix + ".icl" + number + ".insts.others";
     temp.desc = "CPU for ICL core " + number + " executed other instructions";
     list.push_back(temp);
+
+    temp.name = prefix + ".icl" + number + ".steal";
+    temp.desc = "CPU for ICL core " + number + " stolen jobs";
+    list.push_back(temp);
   }
 
   for (uint32_t i = 0; i < ftlCore.size(); i++) {
@@ -896,6 +1376,29 @@ void CPU::getStatList(std::vector<Stats> &list, std::string prefix) {
     temp.name = prefix + ".ftl" + number + ".insts.others";
     temp.desc = "CPU for FTL core " + number + " executed other instructions";
     list.push_back(temp);
+
+    temp.name = prefix + ".ftl" + number + ".steal";
+    temp.desc = "CPU for FTL core " + number + " stolen jobs";
+    list.push_back(temp);
+  }
+
+  const char *layers[] = {"hil", "icl", "ftl"};
+  const char *names[] = {"HIL", "ICL", "FTL"};
+
+  for (uint32_t i = 0; i < 3; i++) {
+    std::string name = names[i];
+
+    temp.name = prefix + "." + layers[i] + ".energy";
+    temp.desc = "CPU for " + name + " energy consumption (pJ)";
+    list.push_back(temp);
+
+    temp.name = prefix + "." + layers[i] + ".clock.average";
+    temp.desc = "CPU for " + name + " average clock speed (MHz)";
+    list.push_back(temp);
+
+    temp.name = prefix + "." + layers[i] + ".clock.change";
+    temp.desc = "CPU for " + name + " clock change count";
+    list.push_back(temp);
   }
 }
 
@@ -910,6 +1413,7 @@ void CPU::getStatValues(std::vector<double> &values) {
     values.push_back(stat.instStat.arithmetic);
     values.push_back(stat.instStat.floatingPoint);
     values.push_back(stat.instStat.otherInsts);
+    values.push_back(stat.steal);
   }
 
   for (auto &core : iclCore) {
@@ -922,6 +1426,7 @@ void CPU::getStatValues(std::vector<double> &values) {
     values.push_back(stat.instStat.arithmetic);
     values.push_back(stat.instStat.floatingPoint);
     values.push_back(stat.instStat.otherInsts);
+    values.push_back(stat.steal);
   }
 
   for (auto &core : ftlCore) {
@@ -934,31 +1439,111 @@ void CPU::getStatValues(std::vector<double> &values) {
     values.push_back(stat.instStat.arithmetic);
     values.push_back(stat.instStat.floatingPoint);
     values.push_back(stat.instStat.otherInsts);
+    values.push_back(stat.steal);
+  }
+
+  CorePool *pools[] = {&hilCore, &iclCore, &ftlCore};
+
+  for (auto pool : pools) {
+    pool->updateEnergy();
+
+    values.push_back(pool->getEnergy());
+    values.push_back(pool->getAverageClock(lastResetStat));
+    values.push_back(pool->getClockChange());
   }
 }
 
 void CPU::resetStatValues() {
   lastResetStat = getTick();
 
-  for (auto &core : hilCore) {
-    auto &stat = core.getStat();
+  hilCore.resetStat();
+  iclCore.resetStat();
+  ftlCore.resetStat();
 
-    stat.busy = 0;
-    stat.instStat = InstStat();
+  for (auto &list : profile) {
+    for (auto &iter : list) {
+      iter = Profile();
+    }
   }
+}
 
-  for (auto &core : iclCore) {
-    auto &stat = core.getStat();
+void CPU::writeProfile() {
+  std::string profileFile = conf.readString(CONFIG_CPU, CPU_PROFILE_FILE);
+  std::string foldedFile = conf.readString(CONFIG_CPU, CPU_FOLDED_STACK_FILE);
+  std::vector<std::pair<uint16_t, uint16_t>> list;
+  uint64_t total = 0;
 
-    stat.busy = 0;
-    stat.instStat = InstStat();
+  if (profileFile.length() == 0 && foldedFile.length() == 0) {
+    return;
   }
 
-  for (auto &core : ftlCore) {
-    auto &stat = core.getStat();
+  for (uint16_t ns = 0; ns < NAMESPACE_NUM; ns++) {
+    for (uint16_t fct = 0; fct < FUNCTION_NUM; fct++) {
+      if (profile[ns][fct].count > 0) {
+        list.push_back(std::make_pair(ns, fct));
+        total += profile[ns][fct].busy;
+      }
+    }
+  }
 
-    stat.busy = 0;
-    stat.instStat = InstStat();
+  // Sort by busy ticks, descending
+  std::sort(list.begin(), list.end(),
+            [this](const std::pair<uint16_t, uint16_t> &a,
+                   const std::pair<uint16_t, uint16_t> &b) -> bool {
+              return profile[a.first][a.second].busy >
+                     profile[b.first][b.second].busy;
+            });
+
+  if (profileFile.length() > 0) {
+    std::ofstream file(profileFile);
+    char line[256];
+
+    if (!file.is_open()) {
+      warn("Failed to open profile file %s", profileFile.c_str());
+    }
+    else {
+      snprintf(line, 256, "%-5s %-18s %-22s %10s %14s %16s %6s %16s %12s\n",
+               "Layer", "Namespace", "Function", "Count", "Cycles", "Busy(ps)",
+               "Busy%", "Wait(ps)", "AvgWait(ps)");
+      file << line;
+
+      for (auto &iter : list) {
+        Profile &prof = profile[iter.first][iter.second];
+
+        snprintf(line, 256,
+                 "%-5s %-18s %-22s %10" PRIu64 " %14" PRIu64 " %16" PRIu64
+                 " %6.2f %16" PRIu64 " %12" PRIu64 "\n",
+                 layerName[iter.first], NAMESPACE_NAME[iter.first],
+                 FUNCTION_NAME[iter.second], prof.count, prof.cycles,
+                 prof.busy, total > 0 ? prof.busy * 100. / total : 0.,
+                 prof.wait, prof.wait / prof.count);
+        file << line;
+      }
+    }
+  }
+
+  if (foldedFile.length() > 0) {
+    std::ofstream file(foldedFile);
+
+    if (!file.is_open()) {
+      warn("Failed to open folded stack file %s", foldedFile.c_str());
+    }
+    else {
+      // Queue wait is child frame of function, like off-CPU time
+      for (auto &iter : list) {
+        Profile &prof = profile[iter.first][iter.second];
+        std::string stack = std::string(layerName[iter.first]) + ";" +
+                            NAMESPACE_NAME[iter.first] + ";" +
+                            FUNCTION_NAME[iter.second];
+
+        if (prof.busy > 0) {
+          file << stack << " " << prof.busy << std::endl;
+        }
+        if (prof.wait > 0) {
+          file << stack << ";queue_wait " << prof.wait << std::endl;
+        }
+      }
+    }
   }
 }
 
@@ -998,6 +1583,8 @@ void CPU::printLastStat() {
     debugprint(LOG_CPU, "  Runtime Dynamic: %lf W",
                power.level3.runtimeDynamic);
   }
+
+  writeProfile();
 }
 
 }  // namespace CPU
@@ -23,8 +23,6 @@
 #define __CPU_CPU__
 
 #include <cinttypes>
-#include <queue>
-#include <unordered_map>
 #include <vector>
 
 #include "cpu/def.hh"
@@ -47,24 +45,39 @@ typedef struct _InstStat {
   uint64_t floatingPoint;
   uint64_t otherInsts;
 
-  // Total times in ps to execute this insturcion group
-  uint64_t latency;
+  // Total cycles to execute this insturcion group
+  uint64_t cycles;
 
   _InstStat();
-  _InstStat(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
-            uint64_t);
+  _InstStat(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
   _InstStat &operator+=(const _InstStat &);
   uint64_t sum();
 } InstStat;
 
+typedef struct _Profile {
+  uint64_t count;   //!< # invocations
+  uint64_t cycles;  //!< Executed cycles
+  uint64_t busy;    //!< Executed ticks
+  uint64_t wait;    //!< Ticks waited in queue of core
+
+  _Profile();
+  void add(uint64_t, uint64_t);
+} Profile;
+
 typedef struct _JobEntry {
   DMAFunction func;
   void *context;
   InstStat *inst;
+  Profile *profile;
   uint64_t submitAt;
   uint64_t delay;
+  uint64_t latency;  //!< Latency at clock of executing core
 
-  _JobEntry(DMAFunction &, void *, InstStat *);
+  // Links in job queue of core or free list of job pool
+  _JobEntry *prev;
+  _JobEntry *next;
+
+  _JobEntry();
 } JobEntry;
 
 class CPU : public StatObject {
@@ -72,19 +85,61 @@ class CPU : public StatObject {
   struct CoreStat {
     InstStat instStat;
     uint64_t busy;
+    uint64_t steal;  //!< # jobs stolen from other cores
 
     CoreStat();
   };
 
+  // Job entries are reused through free list, so job entry itself is not
+  // allocated once pool has grown to the maximum # outstanding jobs. Callback
+  // whose captures exceed small buffer of std::function allocates when it is
+  // copied, so callers move their callback into execute().
+  class JobPool {
+   private:
+    std::vector<JobEntry *> chunks;
+    JobEntry *freeList;
+
+   public:
+    JobPool();
+    ~JobPool();
+
+    JobEntry *allocate();
+    void release(JobEntry *);
+  };
+
+  // Intrusive FIFO of job entries
+  class JobQueue {
+   private:
+    JobEntry *head;
+    JobEntry *tail;
+    uint64_t count;
+
+   public:
+    JobQueue();
+
+    void push(JobEntry *);
+    JobEntry *front();
+    JobEntry *back();
+    void popFront();
+    void popBack();
+    uint64_t size();
+  };
+
+  class CorePool;
+
   class Core {
    private:
     bool busy;
 
     Event jobEvent;
-    std::queue<JobEntry> jobs;
+    JobQueue jobs;
 
     CoreStat stat;
 
+    CorePool *pool;
+    JobPool *jobPool;
+    uint32_t id;  //!< Index in pool
+
     void handleJob();
     void jobDone();
 
@@ -92,13 +147,79 @@ class CPU : public StatObject {
     Core();
     ~Core();
 
-    void submitJob(JobEntry, uint64_t = 0);
+    void submitJob(JobEntry *, uint64_t = 0);
 
-    void addStat(InstStat &);
+    uint64_t addStat(InstStat &);
 
     bool isBusy();
     uint64_t getJobListSize();
     CoreStat &getStat();
+
+    void setPool(CorePool *, JobPool *, uint32_t);
+    void steal(Core &);
+  };
+
+  // Cores of one layer, kept in binary heap ordered by selection priority
+  class CorePool {
+   private:
+    std::vector<Core> cores;
+    std::vector<uint32_t> heap;      //!< Core index, best core at front
+    std::vector<uint32_t> position;  //!< Heap index of each core
+
+    std::vector<CorePool *> siblings;  //!< Steal targets, own pool first
+    uint64_t stealLatency;
+
+    // DVFS
+    uint64_t maxClock;     //!< Clock of highest level in Hz
+    uint32_t levelCount;   //!< Highest level
+    uint32_t level;        //!< Current level
+    uint64_t clockPeriod;  //!< Clock period of current level in ps
+    uint64_t clockChange;
+
+    // Power
+    float dynamicPower;  //!< mW at highest level
+    float leakagePower;  //!< mW at highest level
+    uint64_t lastUpdate;
+    uint64_t lastBusy;     //!< Busy ticks at lastUpdate
+    uint64_t sampledBusy;  //!< Busy ticks at last governor sample
+    double energy;         //!< pJ
+    double clockSum;       //!< Sum of MHz * ps
+
+    bool prior(uint32_t, uint32_t);
+    void swap(uint32_t, uint32_t);
+    void siftUp(uint32_t);
+    void siftDown(uint32_t);
+
+   public:
+    CorePool();
+
+    void init(uint32_t, JobPool *);
+    void update(uint32_t);
+    Core &select();
+    void resetStat();
+
+    void setSteal(std::vector<CorePool *> &, uint64_t);
+    uint64_t getStealLatency();
+    Core *findVictim();
+    void wakeup(Core &);
+
+    void setDVFS(uint64_t, uint32_t, float, float);
+    uint64_t getLatency(InstStat &);
+    uint64_t getMaxClock();
+    uint64_t getClock();
+    uint32_t getLevel();
+    void setLevel(uint32_t);
+    uint64_t getBusy();
+    uint64_t getLoad(GOVERNOR, uint64_t);
+    void updateEnergy();
+    double getEnergy();
+    double getAverageClock(uint64_t);
+    uint64_t getClockChange();
+
+    uint32_t size();
+    Core &at(uint32_t);
+    std::vector<Core>::iterator begin();
+    std::vector<Core>::iterator end();
   };
 
   ConfigReader &conf;
@@ -107,16 +228,37 @@ class CPU : public StatObject {
   uint64_t clockSpeed;
   uint64_t clockPeriod;
 
+  JobPool jobPool;
+
   // Cores
-  std::vector<Core> hilCore;
-  std::vector<Core> iclCore;
-  std::vector<Core> ftlCore;
+  CorePool hilCore;
+  CorePool iclCore;
+  CorePool ftlCore;
+  CorePool *corePool[NAMESPACE_NUM];  //!< nullptr if pool has no core
+  const char *layerName[NAMESPACE_NUM];
+
+  // DVFS
+  GOVERNOR governor;
+  uint64_t dvfsInterval;
+  uint32_t dvfsLevel;
+  uint32_t upThreshold;
+  uint32_t downThreshold;
+  Event dvfsEvent;
 
   // CPIs
-  std::unordered_map<uint16_t, std::unordered_map<uint16_t, InstStat>> cpi;
+  InstStat cpi[NAMESPACE_NUM][FUNCTION_NUM];
+  bool cpiDefined[NAMESPACE_NUM][FUNCTION_NUM];
+
+  // Firmware execution profile
+  Profile profile[NAMESPACE_NUM][FUNCTION_NUM];
 
-  uint32_t leastBusyCPU(std::vector<Core> &);
+  void setCPI(uint16_t, uint16_t, InstStat);
+  InstStat *getCPI(NAMESPACE, FUNCTION);
+  Core *selectCore(NAMESPACE);
+  JobEntry *allocateJob(NAMESPACE, FUNCTION, void *);
+  void scaleClock(uint64_t);
   void calculatePower(Power &);
+  void writeProfile();
 
  public:
   CPU(ConfigReader &);
@@ -124,6 +266,8 @@ class CPU : public StatObject {
 
   void execute(NAMESPACE, FUNCTION, DMAFunction &, void * = nullptr,
                uint64_t = 0);
+  void execute(NAMESPACE, FUNCTION, DMAFunction &&, void * = nullptr,
+               uint64_t = 0);
   uint64_t applyLatency(NAMESPACE, FUNCTION);
 
   void getStatList(std::vector<Stats> &, std::string) override;
@@ -42,6 +42,8 @@ typedef enum : uint16_t {
   NVME__OCSSD,
   UFS__DEVICE,
   SATA__DEVICE,
+
+  NAMESPACE_NUM,
 } NAMESPACE;
 
 typedef enum : uint16_t {
@@ -109,6 +111,8 @@ typedef enum : uint16_t {
   WRITE_NCQ,
   WRITE_DMA_SETUP,
   WRITE_DMA_DONE,
+
+  FUNCTION_NUM,
 } FUNCTION;
 
 }  // namespace CPU
@@ -113,8 +113,7 @@ for func in funcList:
 
 # Everything is done
 # Print result
-template = """cpi.find({1})->second.insert(
-    {{{2}, InstStat({4}, {5}, {6}, {7}, {8}, {3}, clockPeriod)}});"""
+template = 'setCPI({1}, {2}, InstStat({4}, {5}, {6}, {7}, {8}, {3}));'
 
 for data in result:
     print(template.format(data[0], data[1], data[2],
@@ -20,6 +20,7 @@
 #include "dram/abstract_dram.hh"
 
 #include <cstring>
+#include <limits>
 
 #include "util/algorithm.hh"
 
@@ -28,18 +29,41 @@ namespace SimpleSSD {
 namespace DRAM {
 
 AbstractDRAM::AbstractDRAM(ConfigReader &c)
-    : conf(c), totalEnergy(0.0), totalPower(0.0) {
+    : conf(c),
+      totalEnergy(0.0),
+      totalPower(0.0),
+      addressMap(conf.getDRAMStructure()->chipSize *
+                     conf.getDRAMStructure()->chip *
+                     conf.getDRAMStructure()->rank *
+                     conf.getDRAMStructure()->channel,
+                 conf.getDRAMStructure()->pageSize),
+      pendingCommand(0),
+      pendingCycle(0),
+      energyAt(0),
+      busyUntil(0),
+      stateAt(0),
+      powerDownCount(0),
+      selfRefreshCount(0),
+      wakeupLatency(0) {
   pStructure = conf.getDRAMStructure();
   pTiming = conf.getDRAMTiming();
   pPower = conf.getDRAMPower();
+  useEnergy = conf.readBoolean(CONFIG_DRAM, DRAM_ENABLE_ENERGY);
+  energyBatch = conf.readUint(CONFIG_DRAM, DRAM_ENERGY_BATCH);
+  powerDownThreshold = conf.readUint(CONFIG_DRAM, DRAM_POWER_DOWN_THRESHOLD);
+  selfRefreshThreshold =
+      conf.readUint(CONFIG_DRAM, DRAM_SELF_REFRESH_THRESHOLD);
 
-  convertMemspec();
+  memset(residency, 0, sizeof(residency));
 
-  dramPower = new libDRAMPower(spec, false);
+  convertMemspec();
+  initPower(1);
 }
 
 AbstractDRAM::~AbstractDRAM() {
-  delete dramPower;
+  for (auto iter : dramPower) {
+    delete iter;
+  }
 }
 
 void AbstractDRAM::convertMemspec() {
@@ -112,6 +136,218 @@ void AbstractDRAM::convertMemspec() {
   spec.memPowerSpec.vdd2 = pPower->pVDD[1];
 }
 
+// Create DRAMPower instances, one for each independently operated device
+void AbstractDRAM::initPower(uint32_t count) {
+  for (auto iter : dramPower) {
+    delete iter;
+  }
+
+  dramPower.clear();
+
+  for (uint32_t i = 0; i < count; i++) {
+    dramPower.push_back(new libDRAMPower(spec, false));
+  }
+}
+
+uint32_t AbstractDRAM::addRegion(std::string name, uint64_t size) {
+  return addressMap.addRegion(name, size);
+}
+
+void *AbstractDRAM::getAddress(uint32_t idx, uint64_t offset) {
+  return (void *)addressMap.getAddress(idx, offset);
+}
+
+// Return device address of access and update statistics of region
+uint64_t AbstractDRAM::translate(void *buffer, uint64_t size, bool write) {
+  return addressMap.translate(buffer, size, write);
+}
+
+void AbstractDRAM::doCommand(Data::MemCommand::cmds cmd, uint32_t device,
+                             uint32_t bank, uint64_t cycle) {
+  if (useEnergy) {
+    dramPower[device]->doCommand(cmd, bank, cycle);
+
+    pendingCommand++;
+  }
+}
+
+// Issue command to all devices
+void AbstractDRAM::doCommand(Data::MemCommand::cmds cmd, uint64_t cycle) {
+  if (useEnergy) {
+    for (auto iter : dramPower) {
+      iter->doCommand(cmd, 0, cycle);
+    }
+
+    pendingCommand++;
+  }
+}
+
+// Called when access is finished at cycle
+void AbstractDRAM::updateEnergy(uint64_t cycle) {
+  pendingCycle = MAX(pendingCycle, cycle);
+
+  if (pendingCommand >= energyBatch) {
+    flushEnergy();
+  }
+}
+
+// Calculate energy of all pending commands
+void AbstractDRAM::flushEnergy() {
+  if (!useEnergy || pendingCycle <= energyAt) {
+    return;
+  }
+
+  totalPower = 0.0;
+
+  for (auto iter : dramPower) {
+    iter->calcWindowEnergy(pendingCycle);
+
+    totalEnergy += iter->getEnergy().window_energy;
+    totalPower += iter->getPower().average_power;
+  }
+
+  energyAt = pendingCycle;
+  pendingCommand = 0;
+}
+
+// Return when DRAM enters power-down and self-refresh after last access
+void AbstractDRAM::getIdlePeriod(uint64_t &powerDownAt,
+                                 uint64_t &selfRefreshAt) {
+  selfRefreshAt = std::numeric_limits<uint64_t>::max();
+
+  if (selfRefreshThreshold > 0) {
+    selfRefreshAt = busyUntil + selfRefreshThreshold;
+  }
+
+  powerDownAt = selfRefreshAt;
+
+  if (powerDownThreshold > 0) {
+    powerDownAt = MIN(busyUntil + powerDownThreshold, selfRefreshAt);
+  }
+}
+
+// Accumulate residency of each state until tick
+void AbstractDRAM::updateState(uint64_t tick) {
+  uint64_t powerDownAt;
+  uint64_t selfRefreshAt;
+  uint64_t at = stateAt;
+  uint64_t end;
+
+  if (tick <= stateAt) {
+    return;
+  }
+
+  getIdlePeriod(powerDownAt, selfRefreshAt);
+
+  if (at < busyUntil) {
+    end = MIN(tick, busyUntil);
+    residency[ACTIVE] += end - at;
+    at = end;
+  }
+
+  if (at < tick && at < powerDownAt) {
+    end = MIN(tick, powerDownAt);
+    residency[IDLE] += end - at;
+    at = end;
+  }
+
+  if (at < tick && at < selfRefreshAt) {
+    if (at == powerDownAt) {
+      prechargeAll(at);
+      doCommand(Data::MemCommand::PDN_F_PRE, at / pTiming->tCK);
+      powerDownCount++;
+    }
+
+    end = MIN(tick, selfRefreshAt);
+    residency[POWER_DOWN_PRECHARGE] += end - at;
+    at = end;
+  }
+
+  if (at < tick) {
+    if (at == selfRefreshAt) {
+      if (powerDownAt < selfRefreshAt) {
+        doCommand(Data::MemCommand::PUP_PRE, at / pTiming->tCK);
+      }
+      else {
+        prechargeAll(at);
+      }
+
+      doCommand(Data::MemCommand::SREN, at / pTiming->tCK);
+      selfRefreshCount++;
+    }
+
+    residency[SELF_REFRESH] += tick - at;
+  }
+
+  stateAt = tick;
+}
+
+DRAMState AbstractDRAM::getState(uint64_t tick) {
+  uint64_t powerDownAt;
+  uint64_t selfRefreshAt;
+
+  getIdlePeriod(powerDownAt, selfRefreshAt);
+
+  if (tick < busyUntil) {
+    return ACTIVE;
+  }
+  else if (tick > selfRefreshAt) {
+    return SELF_REFRESH;
+  }
+  else if (tick > powerDownAt) {
+    return POWER_DOWN_PRECHARGE;
+  }
+
+  return IDLE;
+}
+
+// Wake up DRAM for access at tick and return exit latency
+uint64_t AbstractDRAM::powerUp(uint64_t tick) {
+  uint64_t latency = 0;
+
+  updateState(tick);
+
+  switch (getState(tick)) {
+    case POWER_DOWN_PRECHARGE:
+      latency = pStructure->useDLL ? pTiming->tXPDLL : pTiming->tXP;
+
+      doCommand(Data::MemCommand::PUP_PRE, tick / pTiming->tCK);
+
+      break;
+    case SELF_REFRESH:
+      latency = pStructure->useDLL ? pTiming->tXSDLL : pTiming->tXS;
+
+      doCommand(Data::MemCommand::SREX, tick / pTiming->tCK);
+
+      break;
+    default:
+      return 0;
+  }
+
+  wakeupLatency += latency;
+  setBusy(tick + latency);
+
+  return latency;
+}
+
+void AbstractDRAM::setBusy(uint64_t tick) {
+  busyUntil = MAX(busyUntil, tick);
+}
+
+bool AbstractDRAM::inSelfRefresh(uint64_t tick) {
+  updateState(tick);
+
+  return getState(tick) == SELF_REFRESH;
+}
+
+void AbstractDRAM::submit(void *, uint64_t, bool, DMAFunction &, void *) {
+  panic("Asynchronous interface is not supported by this DRAM model");
+}
+
+void AbstractDRAM::post(void *buffer, uint64_t size, uint64_t &tick) {
+  write(buffer, size, tick);
+}
+
 void AbstractDRAM::getStatList(std::vector<Stats> &list, std::string prefix) {
   Stats temp;
 
@@ -122,19 +358,70 @@ void AbstractDRAM::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.name = prefix + "power";
   temp.desc = "Total power comsumed by embedded DRAM (mW)";
   list.push_back(temp);
+
+  temp.name = prefix + "state.active.time";
+  temp.desc = "Time spent on access (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.idle.time";
+  temp.desc = "Time spent on idle standby (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.power_down.time";
+  temp.desc = "Time spent on precharge power-down (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.self_refresh.time";
+  temp.desc = "Time spent on self-refresh (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.power_down.count";
+  temp.desc = "Number of power-down entries";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.self_refresh.count";
+  temp.desc = "Number of self-refresh entries";
+  list.push_back(temp);
+
+  temp.name = prefix + "state.wakeup_latency";
+  temp.desc = "Total exit latency of power-down and self-refresh (ps)";
+  list.push_back(temp);
+
+  addressMap.getStatList(list, prefix);
 }
 
 void AbstractDRAM::getStatValues(std::vector<double> &values) {
+  updateState(getTick());
+  flushEnergy();
+
   values.push_back(totalEnergy);
   values.push_back(totalPower);
+  values.push_back(residency[ACTIVE]);
+  values.push_back(residency[IDLE]);
+  values.push_back(residency[POWER_DOWN_PRECHARGE]);
+  values.push_back(residency[SELF_REFRESH]);
+  values.push_back(powerDownCount);
+  values.push_back(selfRefreshCount);
+  values.push_back(wakeupLatency);
+
+  addressMap.getStatValues(values);
 }
 
 void AbstractDRAM::resetStatValues() {
   // calcWindowEnergy clears old data
-  dramPower->calcWindowEnergy(getTick() / pTiming->tCK);
+  updateEnergy(getTick() / pTiming->tCK);
+  flushEnergy();
 
   totalEnergy = 0.0;
   totalPower = 0.0;
+
+  updateState(getTick());
+  memset(residency, 0, sizeof(residency));
+  powerDownCount = 0;
+  selfRefreshCount = 0;
+  wakeupLatency = 0;
+
+  addressMap.resetStatValues();
 }
 
 }  // namespace DRAM
@@ -21,7 +21,9 @@
 #define __DRAM_ABSTRACT_DRAM__
 
 #include <cinttypes>
+#include <vector>
 
+#include "dram/address_map.hh"
 #include "libdrampower/LibDRAMPower.h"
 #include "util/simplessd.hh"
 
@@ -46,20 +48,70 @@ class AbstractDRAM : public StatObject {
   Config::DRAMPower *pPower;
 
   Data::MemorySpecification spec;
-  libDRAMPower *dramPower;
+  std::vector<libDRAMPower *> dramPower;  //!< One per channel and rank
 
   void convertMemspec();
+  void initPower(uint32_t);
 
   double totalEnergy;  // Unit: pJ
   double totalPower;   // Unit: mW
 
+  AddressMap addressMap;
+
+  uint64_t translate(void *, uint64_t, bool);
+  void doCommand(Data::MemCommand::cmds, uint32_t, uint32_t, uint64_t);
+  void doCommand(Data::MemCommand::cmds, uint64_t);
+  void updateEnergy(uint64_t);
+  void flushEnergy();
+
+  uint64_t powerUp(uint64_t);
+  void setBusy(uint64_t);
+  bool inSelfRefresh(uint64_t);
+
+  // Close all open rows before entering power-down or self-refresh
+  virtual void prechargeAll(uint64_t) {}
+
+ private:
+  bool useEnergy;
+  uint64_t energyBatch;
+  uint64_t pendingCommand;  //!< # commands not passed to calcWindowEnergy
+  uint64_t pendingCycle;    //!< Last cycle of pending commands
+  uint64_t energyAt;        //!< Energy is calculated until this cycle
+
+  // Low power state is evaluated lazily from idle time of last access
+  uint64_t powerDownThreshold;
+  uint64_t selfRefreshThreshold;
+  uint64_t busyUntil;  //!< Last access finishes at this tick
+  uint64_t stateAt;    //!< Residency is calculated until this tick
+  uint64_t residency[SELF_REFRESH + 1];
+  uint64_t powerDownCount;
+  uint64_t selfRefreshCount;
+  uint64_t wakeupLatency;
+
+  void getIdlePeriod(uint64_t &, uint64_t &);
+  void updateState(uint64_t);
+  DRAMState getState(uint64_t);
+
  public:
   AbstractDRAM(ConfigReader &);
   virtual ~AbstractDRAM();
 
+  // Allocate region in device address space and return region ID
+  uint32_t addRegion(std::string, uint64_t);
+
+  // Return device address of offset in region, used as buffer of read/write
+  void *getAddress(uint32_t, uint64_t);
+
   virtual void read(void *, uint64_t, uint64_t &) = 0;
   virtual void write(void *, uint64_t, uint64_t &) = 0;
 
+  // Asynchronous interface, func is called when access is finished
+  virtual void submit(void *, uint64_t, bool, DMAFunction &, void * = nullptr);
+
+  // Write issued at tick which caller does not wait for. Models with request
+  // queue leave tick unchanged, others access synchronously and update tick.
+  virtual void post(void *, uint64_t, uint64_t &);
+
   // TEMP: Should be removed on v2.2
   virtual void setScheduling(bool) {}
   virtual bool isScheduling() { return true; }
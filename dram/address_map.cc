@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dram/address_map.hh"
+
+#include <algorithm>
+
+#include "util/algorithm.hh"
+#include "util/simplessd.hh"
+
+namespace SimpleSSD {
+
+namespace DRAM {
+
+AddressMap::AddressMap(uint64_t c, uint64_t a)
+    : capacity(c), align(a), allocated(a), nextAddress(a) {}
+
+uint32_t AddressMap::addRegion(std::string name, uint64_t size) {
+  Region region;
+
+  region.name = name;
+  region.base = allocated;
+  region.size = MAX(size, 1);
+  region.readCount = 0;
+  region.readBytes = 0;
+  region.writeCount = 0;
+  region.writeBytes = 0;
+
+  allocated += DIVCEIL(region.size, align) * align;
+
+  if (allocated > capacity) {
+    warn("DRAM region %s exceeds DRAM capacity (%" PRIu64 " / %" PRIu64
+         " bytes)",
+         name.c_str(), allocated, capacity);
+  }
+
+  regions.push_back(region);
+
+  return regions.size() - 1;
+}
+
+uint64_t AddressMap::getAddress(uint32_t idx, uint64_t offset) {
+  Region &region = regions.at(idx);
+
+  return region.base + offset % region.size;
+}
+
+// Resolve nullptr and account access to region containing address
+uint64_t AddressMap::translate(void *buffer, uint64_t size, bool write) {
+  uint64_t address = buffer ? (uint64_t)buffer : nextAddress;
+
+  nextAddress = address + size;
+
+  auto iter = std::upper_bound(
+      regions.begin(), regions.end(), address,
+      [](uint64_t addr, const Region &region) { return addr < region.base; });
+
+  if (iter != regions.begin()) {
+    Region &region = *(--iter);
+
+    if (address < region.base + region.size) {
+      if (write) {
+        region.writeCount++;
+        region.writeBytes += size;
+      }
+      else {
+        region.readCount++;
+        region.readBytes += size;
+      }
+    }
+  }
+
+  return address;
+}
+
+void AddressMap::getStatList(std::vector<Stats> &list, std::string prefix) {
+  Stats temp;
+
+  for (auto &iter : regions) {
+    std::string name = prefix + "region." + iter.name + ".";
+
+    temp.name = name + "size";
+    temp.desc = "Size of DRAM region in byte";
+    list.push_back(temp);
+
+    temp.name = name + "read.request_count";
+    temp.desc = "Read request count of DRAM region";
+    list.push_back(temp);
+
+    temp.name = name + "read.bytes";
+    temp.desc = "Read data size of DRAM region in byte";
+    list.push_back(temp);
+
+    temp.name = name + "write.request_count";
+    temp.desc = "Write request count of DRAM region";
+    list.push_back(temp);
+
+    temp.name = name + "write.bytes";
+    temp.desc = "Write data size of DRAM region in byte";
+    list.push_back(temp);
+  }
+}
+
+void AddressMap::getStatValues(std::vector<double> &values) {
+  for (auto &iter : regions) {
+    values.push_back(iter.size);
+    values.push_back(iter.readCount);
+    values.push_back(iter.readBytes);
+    values.push_back(iter.writeCount);
+    values.push_back(iter.writeBytes);
+  }
+}
+
+void AddressMap::resetStatValues() {
+  for (auto &iter : regions) {
+    iter.readCount = 0;
+    iter.readBytes = 0;
+    iter.writeCount = 0;
+    iter.writeBytes = 0;
+  }
+}
+
+}  // namespace DRAM
+
+}  // namespace SimpleSSD
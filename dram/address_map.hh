@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __DRAM_ADDRESS_MAP__
+#define __DRAM_ADDRESS_MAP__
+
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+#include "sim/statistics.hh"
+
+namespace SimpleSSD {
+
+namespace DRAM {
+
+/**
+ * \brief Device address space of embedded DRAM
+ *
+ * Each user (mapping table, cache data, ...) allocates one region and accesses
+ * DRAM with device address of region instead of host pointer. Regions are
+ * placed contiguously, aligned to DRAM page size. Address 0 is not used,
+ * because nullptr means continuing from previous access.
+ */
+class AddressMap : public StatObject {
+ private:
+  struct Region {
+    std::string name;
+    uint64_t base;
+    uint64_t size;
+
+    uint64_t readCount;
+    uint64_t readBytes;
+    uint64_t writeCount;
+    uint64_t writeBytes;
+  };
+
+  uint64_t capacity;
+  uint64_t align;
+  uint64_t allocated;    //!< End of last region
+  uint64_t nextAddress;  //!< End of last access
+
+  std::vector<Region> regions;
+
+ public:
+  AddressMap(uint64_t, uint64_t);
+
+  uint32_t addRegion(std::string, uint64_t);
+  uint64_t getAddress(uint32_t, uint64_t);
+  uint64_t translate(void *, uint64_t, bool);
+
+  void getStatList(std::vector<Stats> &, std::string) override;
+  void getStatValues(std::vector<double> &) override;
+  void resetStatValues() override;
+};
+
+}  // namespace DRAM
+
+}  // namespace SimpleSSD
+
+#endif
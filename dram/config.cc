@@ -27,6 +27,12 @@ namespace SimpleSSD {
 namespace DRAM {
 
 const char NAME_DRAM_MODEL[] = "Model";
+const char NAME_DRAM_WRITE_HIGH_WATERMARK[] = "WriteHighWatermark";
+const char NAME_DRAM_WRITE_LOW_WATERMARK[] = "WriteLowWatermark";
+const char NAME_DRAM_ENABLE_ENERGY[] = "EnableEnergy";
+const char NAME_DRAM_ENERGY_BATCH[] = "EnergyBatchSize";
+const char NAME_DRAM_POWER_DOWN_THRESHOLD[] = "PowerDownThreshold";
+const char NAME_DRAM_SELF_REFRESH_THRESHOLD[] = "SelfRefreshThreshold";
 const char NAME_DRAM_STRUCTURE_CHANNEL[] = "Channel";
 const char NAME_DRAM_STRUCTURE_RANK[] = "Rank";
 const char NAME_DRAM_STRUCTURE_BANK[] = "Bank";
@@ -83,6 +89,12 @@ const char NAME_DRAM_POWER_VDD_1[] = "VDD_1";
 
 Config::Config() {
   model = SIMPLE_MODEL;
+  writeHighWatermark = 32;
+  writeLowWatermark = 16;
+  enableEnergy = true;
+  energyBatch = 16384;
+  powerDownThreshold = 0;
+  selfRefreshThreshold = 0;
 
   /* LPDDR3-1600 4Gbit 1x32 */
   dram.channel = 1;
@@ -113,9 +125,9 @@ Config::Config() {
   dramTiming.tRRD = 10000;
   dramTiming.tRRD_L = 0;
   dramTiming.tXAW = 50000;
-  dramTiming.tXP = 0;
+  dramTiming.tXP = 7500;
   dramTiming.tXPDLL = 0;
-  dramTiming.tXS = 0;
+  dramTiming.tXS = 140000;
   dramTiming.tXSDLL = 0;
 
   dramPower.pIDD0[0] = 8.f;
@@ -150,6 +162,24 @@ bool Config::setConfig(const char *name, const char *value) {
   if (MATCH_NAME(NAME_DRAM_MODEL)) {
     model = (MODEL)strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_DRAM_WRITE_HIGH_WATERMARK)) {
+    writeHighWatermark = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DRAM_WRITE_LOW_WATERMARK)) {
+    writeLowWatermark = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DRAM_ENABLE_ENERGY)) {
+    enableEnergy = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_DRAM_ENERGY_BATCH)) {
+    energyBatch = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DRAM_POWER_DOWN_THRESHOLD)) {
+    powerDownThreshold = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DRAM_SELF_REFRESH_THRESHOLD)) {
+    selfRefreshThreshold = strtoul(value, nullptr, 10);
+  }
   else if (MATCH_NAME(NAME_DRAM_STRUCTURE_CHANNEL)) {
     dram.channel = strtoul(value, nullptr, 10);
   }
@@ -316,6 +346,15 @@ bool Config::setConfig(const char *name, const char *value) {
   return ret;
 }
 
+void Config::update() {
+  if (writeHighWatermark == 0) {
+    panic("WriteHighWatermark should be larger than 0");
+  }
+  if (writeLowWatermark >= writeHighWatermark) {
+    panic("WriteLowWatermark should be smaller than WriteHighWatermark");
+  }
+}
+
 int64_t Config::readInt(uint32_t idx) {
   int64_t ret = 0;
 
@@ -328,6 +367,42 @@ int64_t Config::readInt(uint32_t idx) {
   return ret;
 }
 
+uint64_t Config::readUint(uint32_t idx) {
+  uint64_t ret = 0;
+
+  switch (idx) {
+    case DRAM_WRITE_HIGH_WATERMARK:
+      ret = writeHighWatermark;
+      break;
+    case DRAM_WRITE_LOW_WATERMARK:
+      ret = writeLowWatermark;
+      break;
+    case DRAM_ENERGY_BATCH:
+      ret = energyBatch;
+      break;
+    case DRAM_POWER_DOWN_THRESHOLD:
+      ret = powerDownThreshold;
+      break;
+    case DRAM_SELF_REFRESH_THRESHOLD:
+      ret = selfRefreshThreshold;
+      break;
+  }
+
+  return ret;
+}
+
+bool Config::readBoolean(uint32_t idx) {
+  bool ret = false;
+
+  switch (idx) {
+    case DRAM_ENABLE_ENERGY:
+      ret = enableEnergy;
+      break;
+  }
+
+  return ret;
+}
+
 Config::DRAMStructure *Config::getDRAMStructure() {
   return &dram;
 }
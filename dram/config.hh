@@ -28,10 +28,17 @@ namespace DRAM {
 
 typedef enum {
   DRAM_MODEL,
+  DRAM_WRITE_HIGH_WATERMARK,
+  DRAM_WRITE_LOW_WATERMARK,
+  DRAM_ENABLE_ENERGY,
+  DRAM_ENERGY_BATCH,
+  DRAM_POWER_DOWN_THRESHOLD,
+  DRAM_SELF_REFRESH_THRESHOLD,
 } DRAM_CONFIG;
 
 typedef enum {
   SIMPLE_MODEL,
+  TIMING_MODEL,
 } MODEL;
 
 class Config : public BaseConfig {
@@ -89,7 +96,13 @@ class Config : public BaseConfig {
   } DRAMPower;
 
  private:
-  MODEL model;
+  MODEL model;                    //!< Default: SIMPLE_MODEL
+  uint32_t writeHighWatermark;    //!< Default: 32
+  uint32_t writeLowWatermark;     //!< Default: 16
+  bool enableEnergy;              //!< Default: true
+  uint64_t energyBatch;           //!< Default: 16384
+  uint64_t powerDownThreshold;    //!< Default: 0 (Disabled)
+  uint64_t selfRefreshThreshold;  //!< Default: 0 (Disabled)
 
   DRAMStructure dram;
   DRAMTiming dramTiming;
@@ -99,8 +112,11 @@ class Config : public BaseConfig {
   Config();
 
   bool setConfig(const char *, const char *) override;
+  void update() override;
 
   int64_t readInt(uint32_t) override;
+  uint64_t readUint(uint32_t) override;
+  bool readBoolean(uint32_t) override;
 
   DRAMStructure *getDRAMStructure();
   DRAMTiming *getDRAMTiming();
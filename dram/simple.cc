@@ -36,9 +36,15 @@ SimpleDRAM::SimpleDRAM(ConfigReader &p)
                        pStructure->channel / 8.0 / pTiming->tCK;
 
   autoRefresh = allocate([this](uint64_t now) {
-    dramPower->doCommand(Data::MemCommand::REF, 0, now / pTiming->tCK);
+    // DRAM refreshes itself in self-refresh
+    if (!inSelfRefresh(now)) {
+      uint64_t beginAt = now + powerUp(now);
 
-    lastDRAMAccess = MAX(lastDRAMAccess, now + pTiming->tRFC);
+      doCommand(Data::MemCommand::REF, beginAt / pTiming->tCK);
+
+      lastDRAMAccess = MAX(lastDRAMAccess, beginAt + pTiming->tRFC);
+      setBusy(beginAt + pTiming->tRFC);
+    }
 
     schedule(autoRefresh, now + REFRESH_PERIOD);
   });
@@ -73,16 +79,6 @@ uint64_t SimpleDRAM::updateDelay(uint64_t latency, uint64_t &tick) {
   return beginAt;
 }
 
-void SimpleDRAM::updateStats(uint64_t cycle) {
-  dramPower->calcWindowEnergy(cycle);
-
-  auto &energy = dramPower->getEnergy();
-  auto &power = dramPower->getPower();
-
-  totalEnergy += energy.window_energy;
-  totalPower = power.average_power;
-}
-
 void SimpleDRAM::setScheduling(bool enable) {
   ignoreScheduling = !enable;
 }
@@ -91,64 +87,76 @@ bool SimpleDRAM::isScheduling() {
   return !ignoreScheduling;
 }
 
-void SimpleDRAM::read(void *, uint64_t size, uint64_t &tick) {
+void SimpleDRAM::read(void *buffer, uint64_t size, uint64_t &tick) {
+  translate(buffer, size, false);
+
   uint64_t pageCount = (size > 0) ? (size - 1) / pStructure->pageSize + 1 : 0;
   uint64_t latency =
       (uint64_t)(pageCount * (pageFetchLatency +
                               pStructure->pageSize / interfaceBandwidth));
 
+  if (tick > 0) {
+    tick += powerUp(tick);
+  }
+
   uint64_t beginAt = updateDelay(latency, tick);
 
+  setBusy(tick);
+
   // DRAMPower uses cycle unit
   beginAt /= pTiming->tCK;
 
-  dramPower->doCommand(Data::MemCommand::ACT, 0, beginAt);
+  doCommand(Data::MemCommand::ACT, 0, 0, beginAt);
 
   for (uint64_t i = 0; i < pageCount; i++) {
-    dramPower->doCommand(Data::MemCommand::RD, 0,
-                         beginAt + spec.memTimingSpec.RCD);
+    doCommand(Data::MemCommand::RD, 0, 0, beginAt + spec.memTimingSpec.RCD);
 
     beginAt += spec.memTimingSpec.RCD;
   }
 
   beginAt -= spec.memTimingSpec.RCD;
 
-  dramPower->doCommand(Data::MemCommand::PRE, 0,
-                       beginAt + spec.memTimingSpec.RAS);
+  doCommand(Data::MemCommand::PRE, 0, 0, beginAt + spec.memTimingSpec.RAS);
 
   // Stat Update
-  updateStats(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
+  updateEnergy(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
   readStat.count++;
   readStat.size += size;
 }
 
-void SimpleDRAM::write(void *, uint64_t size, uint64_t &tick) {
+void SimpleDRAM::write(void *buffer, uint64_t size, uint64_t &tick) {
+  translate(buffer, size, true);
+
   uint64_t pageCount = (size > 0) ? (size - 1) / pStructure->pageSize + 1 : 0;
   uint64_t latency =
       (uint64_t)(pageCount * (pageFetchLatency +
                               pStructure->pageSize / interfaceBandwidth));
 
+  if (tick > 0) {
+    tick += powerUp(tick);
+  }
+
   uint64_t beginAt = updateDelay(latency, tick);
 
+  setBusy(tick);
+
   // DRAMPower uses cycle unit
   beginAt /= pTiming->tCK;
 
-  dramPower->doCommand(Data::MemCommand::ACT, 0, beginAt);
+  doCommand(Data::MemCommand::ACT, 0, 0, beginAt);
 
   for (uint64_t i = 0; i < pageCount; i++) {
-    dramPower->doCommand(Data::MemCommand::WR, 0,
-                         beginAt + spec.memTimingSpec.RCD);
+    doCommand(Data::MemCommand::WR, 0, 0, beginAt + spec.memTimingSpec.RCD);
 
     beginAt += spec.memTimingSpec.RCD;
   }
 
   beginAt -= spec.memTimingSpec.RCD;
 
-  dramPower->doCommand(Data::MemCommand::PRE, 0,
-                       beginAt + spec.memTimingSpec.RAS);
+  doCommand(Data::MemCommand::PRE, 0, 0, beginAt + spec.memTimingSpec.RAS);
 
   // Stat Update
-  updateStats(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
+  updateEnergy(beginAt + spec.memTimingSpec.RAS + spec.memTimingSpec.RP);
   writeStat.count++;
   writeStat.size += size;
 }
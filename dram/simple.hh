@@ -49,7 +49,6 @@ class SimpleDRAM : public AbstractDRAM {
   Stat writeStat;
 
   uint64_t updateDelay(uint64_t, uint64_t &);
-  void updateStats(uint64_t);
 
  public:
   SimpleDRAM(ConfigReader &p);
@@ -0,0 +1,672 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dram/timing.hh"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "util/algorithm.hh"
+
+namespace SimpleSSD {
+
+namespace DRAM {
+
+#define REFRESH_PERIOD 64000000000
+
+TimingDRAM::Stat::Stat()
+    : count(0),
+      size(0),
+      rowHit(0),
+      rowMiss(0),
+      rowConflict(0),
+      queued(0),
+      waitTick(0) {}
+
+TimingDRAM::TimingDRAM(ConfigReader &p)
+    : AbstractDRAM(p),
+      ignoreScheduling(false),
+      drainCount(0) {
+  uint64_t rankSize = pStructure->chipSize * pStructure->chip;
+
+  burstSize =
+      pStructure->busWidth * pStructure->chip * pStructure->burstLength / 8;
+  columnDelay = MAX(pTiming->tBURST, pTiming->tCCD_L);
+  rowsPerBank = rankSize / pStructure->bank / pStructure->pageSize;
+  capacity = rankSize * pStructure->rank * pStructure->channel;
+
+  if (burstSize == 0 || rowsPerBank == 0) {
+    panic("Invalid DRAM structure");
+  }
+
+  // Each rank of each channel is operated independently, so DRAMPower keeps
+  // state of every rank separately with bank index inside the rank
+  spec.memArchSpec.nbrOfRanks = 1;
+  initPower(pStructure->channel * pStructure->rank);
+
+  channels.resize(pStructure->channel);
+  ranks.resize(pStructure->channel * pStructure->rank);
+  banks.resize(pStructure->channel * pStructure->rank * pStructure->bank);
+
+  for (auto &iter : ranks) {
+    iter.window.resize(pStructure->activationLimit);
+  }
+
+  highWatermark = conf.readUint(CONFIG_DRAM, DRAM_WRITE_HIGH_WATERMARK);
+  lowWatermark = conf.readUint(CONFIG_DRAM, DRAM_WRITE_LOW_WATERMARK);
+
+  controllers.resize(pStructure->channel);
+
+  for (uint32_t i = 0; i < pStructure->channel; i++) {
+    controllers[i].drain = false;
+    controllers[i].event = allocate([this, i](uint64_t now) {
+      dispatch(i, now);
+    });
+  }
+
+  completionEvent = allocate([this](uint64_t now) { complete(now); });
+
+  autoRefresh = allocate([this](uint64_t now) {
+    refresh(now);
+
+    schedule(autoRefresh, now + REFRESH_PERIOD);
+  });
+
+  schedule(autoRefresh, getTick() + REFRESH_PERIOD);
+}
+
+TimingDRAM::~TimingDRAM() {
+  // Completion of queued entries is shared until last entry is issued
+  for (auto &ctrl : controllers) {
+    ctrl.readQueue.splice(ctrl.readQueue.end(), ctrl.writeQueue);
+
+    for (auto &iter : ctrl.readQueue) {
+      if (--iter.completion->remaining == 0) {
+        delete iter.completion;
+      }
+    }
+  }
+
+  for (auto &iter : finished) {
+    delete iter.second;
+  }
+
+  for (auto &iter : freeCompletions) {
+    delete iter;
+  }
+}
+
+void TimingDRAM::decode(uint64_t address, Address &addr) {
+  address = (address % capacity) / pStructure->pageSize;
+
+  addr.channel = address % pStructure->channel;
+  address /= pStructure->channel;
+  addr.bank = address % pStructure->bank;
+  address /= pStructure->bank;
+  addr.rank = address % pStructure->rank;
+  address /= pStructure->rank;
+  addr.row = address % rowsPerBank;
+}
+
+TimingDRAM::Bank &TimingDRAM::getBank(Address &addr) {
+  return banks[(addr.channel * pStructure->rank + addr.rank) *
+                   pStructure->bank +
+               addr.bank];
+}
+
+// Open row of bank and return when column command can be issued
+uint64_t TimingDRAM::activate(Address &addr, Bank &bank, uint64_t tick,
+                              Stat &stat) {
+  uint32_t rankIdx = addr.channel * pStructure->rank + addr.rank;
+  Rank &rank = ranks[rankIdx];
+  uint64_t actAt = MAX(tick, bank.readyAt);
+
+  if (bank.open) {
+    if (bank.row == addr.row) {
+      stat.rowHit++;
+
+      return actAt;
+    }
+
+    actAt = MAX(actAt, bank.preAt);
+
+    doCommand(Data::MemCommand::PRE, rankIdx, addr.bank, actAt / pTiming->tCK);
+
+    actAt += pTiming->tRP;
+    stat.rowConflict++;
+  }
+  else {
+    stat.rowMiss++;
+  }
+
+  // ACT to ACT delay and activation window of rank
+  actAt = MAX(actAt, rank.actAt + pTiming->tRRD);
+
+  if (rank.window.size() > 0) {
+    actAt = MAX(actAt, rank.window[rank.head] + pTiming->tXAW);
+
+    rank.window[rank.head] = actAt;
+    rank.head = (rank.head + 1) % rank.window.size();
+  }
+
+  rank.actAt = actAt;
+
+  doCommand(Data::MemCommand::ACT, rankIdx, addr.bank, actAt / pTiming->tCK);
+
+  bank.open = true;
+  bank.row = addr.row;
+  bank.preAt = actAt + pTiming->tRAS;
+
+  return actAt + pTiming->tRCD;
+}
+
+// Access one row and return when last data is transferred
+uint64_t TimingDRAM::accessRow(Address &addr, uint64_t size, bool write,
+                               uint64_t tick) {
+  Bank &bank = getBank(addr);
+  Channel &channel = channels[addr.channel];
+  uint32_t rankIdx = addr.channel * pStructure->rank + addr.rank;
+  uint64_t bursts = DIVCEIL(size, burstSize);
+  uint64_t latency = write ? pTiming->tCL - pTiming->tCK : pTiming->tCL;
+  uint64_t casAt = activate(addr, bank, tick, write ? writeStat : readStat);
+  uint64_t busAt = channel.busFreeAt;
+
+  // Bus turnaround
+  if (channel.rank != addr.rank) {
+    busAt += pTiming->tCS;
+  }
+  if (channel.write != write) {
+    busAt += write ? pTiming->tRTW : pTiming->tWTR;
+  }
+
+  if (casAt + latency < busAt) {
+    casAt = busAt - latency;
+  }
+
+  uint64_t lastCasAt = casAt + (bursts - 1) * columnDelay;
+  uint64_t finishedAt = lastCasAt + latency + pTiming->tBURST;
+
+  for (uint64_t i = 0; i < bursts; i++) {
+    doCommand(write ? Data::MemCommand::WR : Data::MemCommand::RD, rankIdx,
+              addr.bank, (casAt + i * columnDelay) / pTiming->tCK);
+  }
+
+  bank.readyAt = lastCasAt + columnDelay;
+  bank.preAt = MAX(bank.preAt, write ? finishedAt + pTiming->tWR
+                                     : lastCasAt + pTiming->tRTP);
+
+  channel.busFreeAt = finishedAt;
+  channel.rank = addr.rank;
+  channel.write = write;
+
+  return finishedAt;
+}
+
+void TimingDRAM::access(void *buffer, uint64_t size, bool write,
+                        uint64_t &tick) {
+  Stat &stat = write ? writeStat : readStat;
+  uint64_t address = translate(buffer, size, write);
+  uint64_t latency = write ? pTiming->tCL - pTiming->tCK : pTiming->tCL;
+  uint64_t finishedAt;
+  uint64_t idleAt;
+  Address addr;
+
+  stat.count++;
+  stat.size += size;
+
+  if (tick == 0) {
+    return;
+  }
+
+  tick += powerUp(tick);
+  finishedAt = tick;
+  idleAt = tick;
+
+  while (size > 0) {
+    uint64_t length =
+        MIN(size, pStructure->pageSize - address % pStructure->pageSize);
+
+    decode(address, addr);
+
+    uint64_t rowAt = accessRow(addr, length, write, tick);
+
+    finishedAt = MAX(finishedAt, rowAt);
+
+    // Latency when all banks are idle
+    idleAt += pTiming->tRCD + latency +
+              (DIVCEIL(length, burstSize) - 1) * columnDelay + pTiming->tBURST;
+
+    address += length;
+    size -= length;
+  }
+
+  setBusy(finishedAt);
+  updateEnergy(finishedAt / pTiming->tCK);
+
+  tick = ignoreScheduling ? idleAt : finishedAt;
+}
+
+// Select first ready row hit, or oldest ready access if there is no row hit
+TimingDRAM::EntryIterator TimingDRAM::select(std::list<Entry> &queue,
+                                             uint64_t now, uint64_t &readyAt) {
+  EntryIterator ret = queue.end();
+
+  readyAt = std::numeric_limits<uint64_t>::max();
+
+  for (auto iter = queue.begin(); iter != queue.end(); iter++) {
+    Bank &bank = getBank(iter->addr);
+
+    // Posted write arrives in future
+    if (iter->arrivedAt > now) {
+      readyAt = MIN(readyAt, iter->arrivedAt);
+
+      continue;
+    }
+
+    if (bank.readyAt > now) {
+      readyAt = MIN(readyAt, bank.readyAt);
+
+      continue;
+    }
+
+    if (bank.open && bank.row == iter->addr.row) {
+      return iter;
+    }
+
+    if (ret == queue.end()) {
+      ret = iter;
+    }
+  }
+
+  return ret;
+}
+
+void TimingDRAM::dispatch(uint32_t idx, uint64_t now) {
+  Controller &ctrl = controllers[idx];
+  uint64_t finishedAt = 0;
+
+  while (ctrl.readQueue.size() > 0 || ctrl.writeQueue.size() > 0) {
+    // Drain writes between high and low watermark
+    if (!ctrl.drain && ctrl.writeQueue.size() >= highWatermark) {
+      ctrl.drain = true;
+      drainCount++;
+    }
+    else if (ctrl.drain && ctrl.writeQueue.size() <= lowWatermark) {
+      ctrl.drain = false;
+    }
+
+    bool write = ctrl.drain || ctrl.readQueue.size() == 0;
+    std::list<Entry> *queue = write ? &ctrl.writeQueue : &ctrl.readQueue;
+    uint64_t readyAt;
+    auto iter = select(*queue, now, readyAt);
+
+    // Nothing is ready in selected queue, serve the other queue meanwhile
+    if (iter == queue->end()) {
+      std::list<Entry> *other = write ? &ctrl.readQueue : &ctrl.writeQueue;
+      uint64_t otherAt;
+      auto otherIter = select(*other, now, otherAt);
+
+      if (otherIter != other->end()) {
+        write = !write;
+        queue = other;
+        iter = otherIter;
+      }
+      else {
+        readyAt = MIN(readyAt, otherAt);
+      }
+    }
+
+    Stat &stat = write ? writeStat : readStat;
+
+    if (iter == queue->end()) {
+      uint64_t scheduledAt;
+
+      if (!scheduled(ctrl.event, &scheduledAt)) {
+        schedule(ctrl.event, readyAt);
+      }
+      else if (scheduledAt > readyAt) {
+        deschedule(ctrl.event);
+        schedule(ctrl.event, readyAt);
+      }
+
+      break;
+    }
+
+    Completion *completion = iter->completion;
+    uint64_t rowAt =
+        accessRow(iter->addr, iter->size, write, now + powerUp(now));
+
+    stat.queued++;
+    stat.waitTick += now - iter->arrivedAt;
+
+    completion->finishedAt = MAX(completion->finishedAt, rowAt);
+    finishedAt = MAX(finishedAt, rowAt);
+    setBusy(rowAt);
+
+    if (--completion->remaining == 0) {
+      finish(completion);
+    }
+
+    queue->erase(iter);
+  }
+
+  if (finishedAt > 0) {
+    updateEnergy(finishedAt / pTiming->tCK);
+  }
+}
+
+void TimingDRAM::finish(Completion *completion) {
+  uint64_t scheduledAt;
+
+  finished.push_back(Finished(completion->finishedAt, completion));
+  std::push_heap(finished.begin(), finished.end(), std::greater<Finished>());
+
+  if (scheduled(completionEvent, &scheduledAt)) {
+    if (scheduledAt <= completion->finishedAt) {
+      return;
+    }
+
+    deschedule(completionEvent);
+  }
+
+  schedule(completionEvent, finished.front().first);
+}
+
+void TimingDRAM::complete(uint64_t now) {
+  while (finished.size() > 0 && finished.front().first <= now) {
+    Completion *completion = finished.front().second;
+
+    std::pop_heap(finished.begin(), finished.end(), std::greater<Finished>());
+    finished.pop_back();
+
+    if (completion->func) {
+      completion->func(now, completion->context);
+    }
+
+    releaseCompletion(completion);
+  }
+
+  if (finished.size() > 0 && !scheduled(completionEvent)) {
+    schedule(completionEvent, finished.front().first);
+  }
+}
+
+void TimingDRAM::refresh(uint64_t now) {
+  bool open = false;
+
+  // DRAM refreshes itself in self-refresh
+  if (inSelfRefresh(now)) {
+    return;
+  }
+
+  now += powerUp(now);
+
+  for (auto &iter : banks) {
+    uint64_t beginAt = MAX(now, iter.readyAt);
+
+    if (iter.open) {
+      beginAt = MAX(beginAt, iter.preAt) + pTiming->tRP;
+      open = true;
+    }
+
+    iter.open = false;
+    iter.readyAt = beginAt + pTiming->tRFC;
+  }
+
+  if (open) {
+    doCommand(Data::MemCommand::PREA, now / pTiming->tCK);
+    now += pTiming->tRP;
+  }
+
+  doCommand(Data::MemCommand::REF, now / pTiming->tCK);
+  setBusy(now + pTiming->tRFC);
+}
+
+void TimingDRAM::prechargeAll(uint64_t tick) {
+  bool open = false;
+
+  for (auto &iter : banks) {
+    if (iter.open) {
+      iter.open = false;
+      iter.readyAt = MAX(iter.readyAt, tick + pTiming->tRP);
+      open = true;
+    }
+  }
+
+  if (open) {
+    doCommand(Data::MemCommand::PREA, tick / pTiming->tCK);
+  }
+}
+
+void TimingDRAM::setScheduling(bool enable) {
+  ignoreScheduling = !enable;
+}
+
+bool TimingDRAM::isScheduling() {
+  return !ignoreScheduling;
+}
+
+void TimingDRAM::read(void *buffer, uint64_t size, uint64_t &tick) {
+  access(buffer, size, false, tick);
+}
+
+void TimingDRAM::write(void *buffer, uint64_t size, uint64_t &tick) {
+  access(buffer, size, true, tick);
+}
+
+TimingDRAM::Completion *TimingDRAM::allocateCompletion() {
+  Completion *completion;
+
+  if (freeCompletions.size() > 0) {
+    completion = freeCompletions.back();
+    freeCompletions.pop_back();
+  }
+  else {
+    completion = new Completion();
+  }
+
+  return completion;
+}
+
+void TimingDRAM::releaseCompletion(Completion *completion) {
+  completion->func = nullptr;
+  completion->context = nullptr;
+
+  freeCompletions.push_back(completion);
+}
+
+// Split request into row accesses and queue them, arriving at tick
+void TimingDRAM::enqueue(uint64_t address, uint64_t size, bool write,
+                         uint64_t tick, Completion *completion) {
+  Entry entry;
+
+  completion->remaining = 0;
+  completion->finishedAt = tick;
+
+  entry.arrivedAt = tick;
+  entry.completion = completion;
+
+  // Queue all row accesses before dispatch, so completion is not called early
+  while (size > 0) {
+    entry.size =
+        MIN(size, pStructure->pageSize - address % pStructure->pageSize);
+
+    decode(address, entry.addr);
+
+    Controller &ctrl = controllers[entry.addr.channel];
+
+    if (write) {
+      ctrl.writeQueue.push_back(entry);
+    }
+    else {
+      ctrl.readQueue.push_back(entry);
+    }
+
+    completion->remaining++;
+    address += entry.size;
+    size -= entry.size;
+  }
+
+  for (uint32_t i = 0; i < pStructure->channel; i++) {
+    if (controllers[i].readQueue.size() > 0 ||
+        controllers[i].writeQueue.size() > 0) {
+      dispatch(i, getTick());
+    }
+  }
+}
+
+void TimingDRAM::submit(void *buffer, uint64_t size, bool write,
+                        DMAFunction &func, void *context) {
+  Stat &stat = write ? writeStat : readStat;
+  uint64_t address = translate(buffer, size, write);
+  Completion *completion;
+
+  stat.count++;
+  stat.size += size;
+
+  if (size == 0) {
+    func(getTick(), context);
+
+    return;
+  }
+
+  completion = allocateCompletion();
+  completion->func = func;
+  completion->context = context;
+
+  enqueue(address, size, write, getTick(), completion);
+}
+
+void TimingDRAM::post(void *buffer, uint64_t size, uint64_t &tick) {
+  uint64_t address = translate(buffer, size, true);
+
+  writeStat.count++;
+  writeStat.size += size;
+
+  // Same as synchronous access, tick 0 means initialization
+  if (tick == 0 || size == 0) {
+    return;
+  }
+
+  // Nobody waits for completion, so func is empty
+  enqueue(address, size, true, MAX(tick, getTick()), allocateCompletion());
+}
+
+void TimingDRAM::getStatList(std::vector<Stats> &list, std::string prefix) {
+  Stats temp;
+
+  AbstractDRAM::getStatList(list, prefix);
+
+  temp.name = prefix + "read.request_count";
+  temp.desc = "Read request count";
+  list.push_back(temp);
+
+  temp.name = prefix + "read.bytes";
+  temp.desc = "Read data size in byte";
+  list.push_back(temp);
+
+  temp.name = prefix + "read.row_hit";
+  temp.desc = "Read row access which hit open row";
+  list.push_back(temp);
+
+  temp.name = prefix + "read.row_miss";
+  temp.desc = "Read row access to precharged bank";
+  list.push_back(temp);
+
+  temp.name = prefix + "read.row_conflict";
+  temp.desc = "Read row access which closed other open row";
+  list.push_back(temp);
+
+  temp.name = prefix + "read.queue_latency";
+  temp.desc = "Average time read row access waited in queue (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.request_count";
+  temp.desc = "Write request count";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.bytes";
+  temp.desc = "Write data size in byte";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.row_hit";
+  temp.desc = "Write row access which hit open row";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.row_miss";
+  temp.desc = "Write row access to precharged bank";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.row_conflict";
+  temp.desc = "Write row access which closed other open row";
+  list.push_back(temp);
+
+  temp.name = prefix + "write.queue_latency";
+  temp.desc = "Average time write row access waited in queue (ps)";
+  list.push_back(temp);
+
+  temp.name = prefix + "write_drain";
+  temp.desc = "Number of times write queue reached high watermark";
+  list.push_back(temp);
+
+  temp.name = prefix + "request_count";
+  temp.desc = "Total request count";
+  list.push_back(temp);
+
+  temp.name = prefix + "bytes";
+  temp.desc = "Total data size in byte";
+  list.push_back(temp);
+}
+
+void TimingDRAM::getStatValues(std::vector<double> &values) {
+  AbstractDRAM::getStatValues(values);
+
+  values.push_back(readStat.count);
+  values.push_back(readStat.size);
+  values.push_back(readStat.rowHit);
+  values.push_back(readStat.rowMiss);
+  values.push_back(readStat.rowConflict);
+  values.push_back(readStat.queued > 0
+                       ? (double)readStat.waitTick / readStat.queued
+                       : 0.);
+  values.push_back(writeStat.count);
+  values.push_back(writeStat.size);
+  values.push_back(writeStat.rowHit);
+  values.push_back(writeStat.rowMiss);
+  values.push_back(writeStat.rowConflict);
+  values.push_back(writeStat.queued > 0
+                       ? (double)writeStat.waitTick / writeStat.queued
+                       : 0.);
+  values.push_back(drainCount);
+  values.push_back(readStat.count + writeStat.count);
+  values.push_back(readStat.size + writeStat.size);
+}
+
+void TimingDRAM::resetStatValues() {
+  AbstractDRAM::resetStatValues();
+
+  readStat = Stat();
+  writeStat = Stat();
+  drainCount = 0;
+}
+
+}  // namespace DRAM
+
+}  // namespace SimpleSSD
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __DRAM_TIMING__
+#define __DRAM_TIMING__
+
+#include <list>
+#include <vector>
+
+#include "dram/abstract_dram.hh"
+
+namespace SimpleSSD {
+
+namespace DRAM {
+
+/**
+ * \brief Bank-level DRAM timing model
+ *
+ * Address is split into row, rank, bank, channel and column (from MSB).
+ * Each bank keeps its row buffer open after access (open-page policy), so
+ * access to open row only pays column command, and access to other row pays
+ * precharge and activate. Banks are accessed in parallel, while data bus of
+ * channel is shared by all ranks of channel.
+ *
+ * Requests submitted through submit() or post() are split into row accesses
+ * and queued to read or write queue of each channel. Controller serves reads
+ * first and selects ready row hit first, then the oldest ready access
+ * (FR-FCFS). When write queue reaches high watermark, writes are drained until
+ * low watermark. Posted write may arrive in future, and is not selected until
+ * its arrival tick.
+ * Synchronous read/write calls must return finish tick immediately, so they
+ * are scheduled in arrival order and never wait in queue.
+ *
+ * Request with nullptr buffer continues from the end of previous request.
+ */
+class TimingDRAM : public AbstractDRAM {
+ private:
+  struct Address {
+    uint32_t channel;
+    uint32_t rank;
+    uint32_t bank;
+    uint64_t row;
+  };
+
+  struct Bank {
+    bool open;
+    uint64_t row;      //!< Opened row
+    uint64_t readyAt;  //!< Column command can be issued after this tick
+    uint64_t preAt;    //!< PRE can be issued after this tick
+  };
+
+  struct Rank {
+    uint64_t actAt;                //!< Last ACT of rank
+    std::vector<uint64_t> window;  //!< Last ACTs within tXAW
+    uint32_t head;                 //!< Oldest ACT in window
+  };
+
+  struct Channel {
+    uint64_t busFreeAt;  //!< Data bus is busy until this tick
+    uint32_t rank;       //!< Rank of last data transfer
+    bool write;          //!< Last data transfer was write
+  };
+
+  // Shared by all row accesses generated from one request
+  struct Completion {
+    uint32_t remaining;  //!< # row accesses not issued yet
+    uint64_t finishedAt;
+    DMAFunction func;
+    void *context;
+  };
+
+  struct Entry {
+    Address addr;
+    uint64_t size;
+    uint64_t arrivedAt;
+    Completion *completion;
+  };
+
+  struct Controller {
+    std::list<Entry> readQueue;
+    std::list<Entry> writeQueue;
+    bool drain;  //!< Serving writes until low watermark
+
+    Event event;
+  };
+
+  struct Stat {
+    uint64_t count;
+    uint64_t size;
+    uint64_t rowHit;       //!< Row was already open
+    uint64_t rowMiss;      //!< Bank was precharged
+    uint64_t rowConflict;  //!< Other row was open
+    uint64_t queued;       //!< # row accesses issued from queue
+    uint64_t waitTick;     //!< Sum of queue wait time
+
+    Stat();
+  };
+
+  typedef std::list<Entry>::iterator EntryIterator;
+  typedef std::pair<uint64_t, Completion *> Finished;
+
+  uint64_t rowsPerBank;
+  uint64_t capacity;
+  uint32_t burstSize;
+  uint64_t columnDelay;
+
+  bool ignoreScheduling;
+
+  std::vector<Channel> channels;
+  std::vector<Rank> ranks;
+  std::vector<Bank> banks;
+  std::vector<Controller> controllers;
+
+  uint32_t highWatermark;
+  uint32_t lowWatermark;
+
+  std::vector<Finished> finished;  //!< Min-heap of completion tick
+  std::vector<Completion *> freeCompletions;  //!< Reused by next request
+  Event completionEvent;
+
+  Event autoRefresh;
+
+  Stat readStat;
+  Stat writeStat;
+  uint64_t drainCount;
+
+  void decode(uint64_t, Address &);
+  Bank &getBank(Address &);
+  uint64_t activate(Address &, Bank &, uint64_t, Stat &);
+  uint64_t accessRow(Address &, uint64_t, bool, uint64_t);
+  void access(void *, uint64_t, bool, uint64_t &);
+  Completion *allocateCompletion();
+  void releaseCompletion(Completion *);
+  void enqueue(uint64_t, uint64_t, bool, uint64_t, Completion *);
+  EntryIterator select(std::list<Entry> &, uint64_t, uint64_t &);
+  void dispatch(uint32_t, uint64_t);
+  void finish(Completion *);
+  void complete(uint64_t);
+  void refresh(uint64_t);
+  void prechargeAll(uint64_t) override;
+
+ public:
+  TimingDRAM(ConfigReader &p);
+  ~TimingDRAM();
+
+  void read(void *, uint64_t, uint64_t &) override;
+  void write(void *, uint64_t, uint64_t &) override;
+
+  void submit(void *, uint64_t, bool, DMAFunction &,
+              void * = nullptr) override;
+  void post(void *, uint64_t, uint64_t &) override;
+
+  void setScheduling(bool) override;
+  bool isScheduling() override;
+
+  void getStatList(std::vector<Stats> &, std::string) override;
+  void getStatValues(std::vector<double> &) override;
+  void resetStatValues() override;
+};
+
+}  // namespace DRAM
+
+}  // namespace SimpleSSD
+
+#endif
@@ -60,10 +60,18 @@ PageMapping::PageMapping(ConfigReader &c, Parameter &p, PAL::PAL *l,
 
   bRandomTweak = conf.readBoolean(CONFIG_FTL, FTL_USE_RANDOM_IO_TWEAK);
   bitsetSize = bRandomTweak ? param.ioUnitInPage : 1;
+
+  // 8 bytes (block and page index) per I/O unit
+  mappingRegion = pDRAM->addRegion(
+      "ftl.mapping", status.totalLogicalPages * 8 * param.ioUnitInPage);
 }
 
 PageMapping::~PageMapping() {}
 
+void *PageMapping::getMappingAddress(uint64_t lpn) {
+  return pDRAM->getAddress(mappingRegion, lpn * 8 * param.ioUnitInPage);
+}
+
 bool PageMapping::initialize() {
   uint64_t nPagesToWarmup;
   uint64_t nPagesToInvalidate;
@@ -547,7 +555,8 @@ void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
               panic("Invalid mapping table entry");
             }
 
-            pDRAM->read(&(*mappingList), 8 * param.ioUnitInPage, tick);
+            pDRAM->read(getMappingAddress(lpns.at(idx)),
+                        8 * param.ioUnitInPage, tick);
 
             auto &mapping = mappingList->second.at(idx);
 
@@ -590,21 +599,10 @@ void PageMapping::doGarbageCollection(std::vector<uint32_t> &blocksToReclaim,
 
   // Do actual I/O here
   // This handles PAL2 limitation (SIGSEGV, infinite loop, or so-on)
-  for (auto &iter : readRequests) {
-    beginAt = tick;
-
-    pPAL->read(iter, beginAt);
-
-    readFinishedAt = MAX(readFinishedAt, beginAt);
-  }
-
-  for (auto &iter : writeRequests) {
-    beginAt = readFinishedAt;
+  pPAL->read(readRequests, readFinishedAt);
 
-    pPAL->write(iter, beginAt);
-
-    writeFinishedAt = MAX(writeFinishedAt, beginAt);
-  }
+  writeFinishedAt = readFinishedAt;
+  pPAL->write(writeRequests, writeFinishedAt);
 
   for (auto &iter : eraseRequests) {
     beginAt = readFinishedAt;
@@ -627,10 +625,11 @@ void PageMapping::readInternal(Request &req, uint64_t &tick) {
 
   if (mappingList != table.end()) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8 * req.ioFlag.count(),
+                  tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8, tick);
     }
 
     for (uint32_t idx = 0; idx < bitsetSize; idx++) {
@@ -715,14 +714,17 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
     panic("No such block");
   }
 
+  // Updated mapping is written back without waiting for DRAM
   if (sendToPAL) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
-      pDRAM->write(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8 * req.ioFlag.count(),
+                  tick);
+      pDRAM->post(getMappingAddress(req.lpn), 8 * req.ioFlag.count(),
+                  tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
-      pDRAM->write(&(*mappingList), 8, tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8, tick);
+      pDRAM->post(getMappingAddress(req.lpn), 8, tick);
     }
   }
 
@@ -743,13 +745,17 @@ void PageMapping::writeInternal(Request &req, uint64_t &tick, bool sendToPAL) {
       // Read old data if needed (Only executed when bRandomTweak = false)
       // Maybe some other init procedures want to perform 'partial-write'
       // So check sendToPAL variable
-      if (readBeforeWrite && sendToPAL) {
+      // Nothing to read when super page was never written
+      if (readBeforeWrite && sendToPAL &&
+          mapping.first < param.totalPhysicalBlocks &&
+          mapping.second < param.pagesInBlock) {
         palRequest.blockIndex = mapping.first;
         palRequest.pageIndex = mapping.second;
 
-        // We don't need to read old data
+        // We don't need to read old data, except partially written one
         palRequest.ioFlag = req.ioFlag;
         palRequest.ioFlag.flip();
+        palRequest.ioFlag |= req.partialFlag;
 
         pPAL->read(palRequest, beginAt);
       }
@@ -816,10 +822,11 @@ void PageMapping::trimInternal(Request &req, uint64_t &tick) {
 
   if (mappingList != table.end()) {
     if (bRandomTweak) {
-      pDRAM->read(&(*mappingList), 8 * req.ioFlag.count(), tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8 * req.ioFlag.count(),
+                  tick);
     }
     else {
-      pDRAM->read(&(*mappingList), 8, tick);
+      pDRAM->read(getMappingAddress(req.lpn), 8, tick);
     }
 
     // Do trim
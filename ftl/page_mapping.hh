@@ -51,6 +51,7 @@ class PageMapping : public AbstractFTL {
   bool bReclaimMore;
   bool bRandomTweak;
   uint32_t bitsetSize;
+  uint32_t mappingRegion;  //!< DRAM region of mapping table
 
   struct {
     uint64_t gcCount;
@@ -59,6 +60,7 @@ class PageMapping : public AbstractFTL {
     uint64_t validPageCopies;
   } stat;
 
+  void *getMappingAddress(uint64_t);
   float freeBlockRatio();
   uint32_t convertBlockIdx(uint32_t);
   uint32_t getFreeBlock(uint32_t);
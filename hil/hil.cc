@@ -66,7 +66,7 @@ void HIL::read(Request &req) {
     delete pReq;
   };
 
-  execute(CPU::HIL, CPU::READ, doRead, new Request(req));
+  execute(CPU::HIL, CPU::READ, std::move(doRead), new Request(req));
 }
 
 void HIL::write(Request &req) {
@@ -98,7 +98,7 @@ void HIL::write(Request &req) {
     delete pReq;
   };
 
-  execute(CPU::HIL, CPU::WRITE, doWrite, new Request(req));
+  execute(CPU::HIL, CPU::WRITE, std::move(doWrite), new Request(req));
 }
 
 void HIL::flush(Request &req) {
@@ -120,7 +120,7 @@ void HIL::flush(Request &req) {
     delete pReq;
   };
 
-  execute(CPU::HIL, CPU::FLUSH, doFlush, new Request(req));
+  execute(CPU::HIL, CPU::FLUSH, std::move(doFlush), new Request(req));
 }
 
 void HIL::trim(Request &req) {
@@ -142,7 +142,7 @@ void HIL::trim(Request &req) {
     delete pReq;
   };
 
-  execute(CPU::HIL, CPU::FLUSH, doFlush, new Request(req));
+  execute(CPU::HIL, CPU::FLUSH, std::move(doFlush), new Request(req));
 }
 
 void HIL::format(Request &req, bool erase) {
@@ -167,7 +167,7 @@ void HIL::format(Request &req, bool erase) {
     delete pReq;
   };
 
-  execute(CPU::HIL, CPU::FLUSH, doFlush, new Request(req));
+  execute(CPU::HIL, CPU::FLUSH, std::move(doFlush), new Request(req));
 }
 
 void HIL::getLPNInfo(uint64_t &totalLogicalPages, uint32_t &logicalPageSize) {
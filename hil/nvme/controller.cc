@@ -1545,7 +1545,7 @@ void Controller::work() {
     DMAFunction doRequest = [this](uint64_t, void *) {
       DMAFunction handle = [this](uint64_t now, void *) { handleRequest(now); };
 
-      execute(CPU::NVME__CONTROLLER, CPU::HANDLE_REQUEST, handle);
+      execute(CPU::NVME__CONTROLLER, CPU::HANDLE_REQUEST, std::move(handle));
     };
 
     lastWorkAt = now;
@@ -1565,7 +1565,7 @@ void Controller::work() {
     // Call request event
     requestCounter = 0;
 
-    execute(CPU::NVME__CONTROLLER, CPU::COLLECT_SQ, doRequest);
+    execute(CPU::NVME__CONTROLLER, CPU::COLLECT_SQ, std::move(doRequest));
   };
 
   // Check ready
@@ -1574,8 +1574,8 @@ void Controller::work() {
   }
 
   // Collect requests in SQs
-  CPUContext *pContext =
-      new CPUContext(queueFunction, nullptr, CPU::NVME__CONTROLLER, CPU::WORK);
+  CPUContext *pContext = new CPUContext(std::move(queueFunction), nullptr,
+                                        CPU::NVME__CONTROLLER, CPU::WORK);
 
   collectSQueue(cpuHandler, pContext);
 }
@@ -1597,10 +1597,12 @@ void Controller::handleRequest(uint64_t now) {
     };
 
     if (bUseOCSSD) {
-      execute(CPU::NVME__OCSSD, CPU::SUBMIT_COMMAND, doSubmit, front);
+      execute(CPU::NVME__OCSSD, CPU::SUBMIT_COMMAND, std::move(doSubmit),
+              front);
     }
     else {
-      execute(CPU::NVME__SUBSYSTEM, CPU::SUBMIT_COMMAND, doSubmit, front);
+      execute(CPU::NVME__SUBSYSTEM, CPU::SUBMIT_COMMAND, std::move(doSubmit),
+              front);
     }
   }
 
@@ -1739,7 +1741,7 @@ void Controller::completion() {
         delete pData;
       };
 
-      execute(CPU::NVME__CONTROLLER, CPU::COMPLETION, send, pData);
+      execute(CPU::NVME__CONTROLLER, CPU::COMPLETION, std::move(send), pData);
 
       delete pContext;
     }
@@ -192,7 +192,8 @@ void PRPList::getPRPListFromPRP(uint64_t base, uint64_t size) {
 
   if (pContext->buffer) {
     // Read PRP
-    CPUContext *pCPU = new CPUContext(doRead, pContext, CPU::NVME__PRPLIST,
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__PRPLIST,
                                       CPU::GET_PRPLIST_FROM_PRP);
     pInterface->dmaRead(base, pContext->currentSize, pContext->buffer,
                         cpuHandler, pCPU);
@@ -253,7 +254,7 @@ void PRPList::read(uint64_t offset, uint64_t length, uint8_t *buffer,
 
   DMAContext *readContext = new DMAContext(func, context);
 
-  execute(CPU::NVME__PRPLIST, CPU::READ, doRead, readContext);
+  execute(CPU::NVME__PRPLIST, CPU::READ, std::move(doRead), readContext);
 }
 
 void PRPList::write(uint64_t offset, uint64_t length, uint8_t *buffer,
@@ -303,7 +304,7 @@ void PRPList::write(uint64_t offset, uint64_t length, uint8_t *buffer,
 
   DMAContext *writeContext = new DMAContext(func, context);
 
-  execute(CPU::NVME__PRPLIST, CPU::WRITE, doWrite, writeContext);
+  execute(CPU::NVME__PRPLIST, CPU::WRITE, std::move(doWrite), writeContext);
 }
 
 SGLDescriptor::SGLDescriptor() {
@@ -417,8 +418,8 @@ void SGL::parseSGLSegment(uint64_t address, uint32_t length) {
 
   if (pContext->buffer) {
     // Read segment
-    CPUContext *pCPU = new CPUContext(doRead, pContext, CPU::NVME__SGL,
-                                      CPU::PARSE_SGL_SEGMENT);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__SGL, CPU::PARSE_SGL_SEGMENT);
     pInterface->dmaRead(address, length, pContext->buffer, cpuHandler, pCPU);
   }
   else {
@@ -482,7 +483,7 @@ void SGL::read(uint64_t offset, uint64_t length, uint8_t *buffer,
 
   DMAContext *readContext = new DMAContext(func, context);
 
-  execute(CPU::NVME__SGL, CPU::READ, doRead, readContext);
+  execute(CPU::NVME__SGL, CPU::READ, std::move(doRead), readContext);
 }
 
 void SGL::write(uint64_t offset, uint64_t length, uint8_t *buffer,
@@ -540,7 +541,7 @@ void SGL::write(uint64_t offset, uint64_t length, uint8_t *buffer,
 
   DMAContext *writeContext = new DMAContext(func, context);
 
-  execute(CPU::NVME__SGL, CPU::WRITE, doWrite, writeContext);
+  execute(CPU::NVME__SGL, CPU::WRITE, std::move(doWrite), writeContext);
 }
 
 }  // namespace NVMe
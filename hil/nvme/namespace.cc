@@ -278,7 +278,7 @@ void Namespace::flush(SQEntryWrapper &req, RequestFunction &func) {
 
     pContext->beginAt = getTick();
 
-    execute(CPU::NVME__NAMESPACE, CPU::FLUSH, begin, pContext);
+    execute(CPU::NVME__NAMESPACE, CPU::FLUSH, std::move(begin), pContext);
   }
 }
 
@@ -358,8 +358,8 @@ void Namespace::write(SQEntryWrapper &req, RequestFunction &func) {
     pContext->slba = slba;
     pContext->nlb = nlb;
 
-    CPUContext *pCPU =
-        new CPUContext(doRead, pContext, CPU::NVME__NAMESPACE, CPU::WRITE);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__NAMESPACE, CPU::WRITE);
 
     if (req.useSGL) {
       pContext->dma =
@@ -450,8 +450,8 @@ void Namespace::read(SQEntryWrapper &req, RequestFunction &func) {
     pContext->slba = slba;
     pContext->nlb = nlb;
 
-    CPUContext *pCPU =
-        new CPUContext(doRead, pContext, CPU::NVME__NAMESPACE, CPU::READ);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__NAMESPACE, CPU::READ);
 
     if (req.useSGL) {
       pContext->dma =
@@ -555,8 +555,8 @@ void Namespace::compare(SQEntryWrapper &req, RequestFunction &func) {
     pContext->slba = slba;
     pContext->nlb = nlb;
 
-    CPUContext *pCPU =
-        new CPUContext(doRead, pContext, CPU::NVME__NAMESPACE, CPU::READ);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__NAMESPACE, CPU::READ);
 
     if (req.useSGL) {
       pContext->dma =
@@ -665,7 +665,8 @@ void Namespace::datasetManagement(SQEntryWrapper &req, RequestFunction &func) {
     pContext->beginAt = getTick();
     pContext->slba = nr;
 
-    CPUContext *pCPU = new CPUContext(doTrim, pContext, CPU::NVME__NAMESPACE,
+    CPUContext *pCPU = new CPUContext(std::move(doTrim), pContext,
+                                      CPU::NVME__NAMESPACE,
                                       CPU::DATASET_MANAGEMENT);
 
     if (req.useSGL) {
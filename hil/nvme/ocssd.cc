@@ -855,7 +855,8 @@ void OpenChannelSSD12::physicalBlockErase(SQEntryWrapper &req,
       }
     };
 
-    CPUContext *pCPU = new CPUContext(doErase, pContext, CPU::NVME__OCSSD,
+    CPUContext *pCPU = new CPUContext(std::move(doErase), pContext,
+                                      CPU::NVME__OCSSD,
                                       CPU::PHYSICAL_BLOCK_ERASE);
 
     pContext->beginAt = getTick();
@@ -982,7 +983,8 @@ void OpenChannelSSD12::physicalPageWrite(SQEntryWrapper &req,
       }
     };
 
-    CPUContext *pCPU = new CPUContext(doDMA, pContext, CPU::NVME__OCSSD,
+    CPUContext *pCPU = new CPUContext(std::move(doDMA), pContext,
+                                      CPU::NVME__OCSSD,
                                       CPU::PHYSICAL_PAGE_WRITE);
 
     pContext->beginAt = getTick();
@@ -1108,7 +1110,8 @@ void OpenChannelSSD12::physicalPageRead(SQEntryWrapper &req,
       }
     };
 
-    CPUContext *pCPU = new CPUContext(doDMA, pContext, CPU::NVME__OCSSD,
+    CPUContext *pCPU = new CPUContext(std::move(doDMA), pContext,
+                                      CPU::NVME__OCSSD,
                                       CPU::PHYSICAL_PAGE_READ);
 
     pContext->beginAt = getTick();
@@ -1571,7 +1574,7 @@ void OpenChannelSSD20::readInternal(std::vector<uint64_t> &lbaList,
     delete pContext;
   };
 
-  execute(CPU::NVME__OCSSD, CPU::READ_INTERNAL, doRead, pContext);
+  execute(CPU::NVME__OCSSD, CPU::READ_INTERNAL, std::move(doRead), pContext);
 }
 
 void OpenChannelSSD20::writeInternal(std::vector<uint64_t> &lbaList,
@@ -1682,7 +1685,7 @@ void OpenChannelSSD20::writeInternal(std::vector<uint64_t> &lbaList,
     delete pContext;
   };
 
-  execute(CPU::NVME__OCSSD, CPU::WRITE_INTERNAL, doWrite, pContext);
+  execute(CPU::NVME__OCSSD, CPU::WRITE_INTERNAL, std::move(doWrite), pContext);
 }
 
 void OpenChannelSSD20::eraseInternal(std::vector<uint64_t> &lbaList,
@@ -1786,7 +1789,7 @@ void OpenChannelSSD20::eraseInternal(std::vector<uint64_t> &lbaList,
     delete pContext;
   };
 
-  execute(CPU::NVME__OCSSD, CPU::ERASE_INTERNAL, doErase, pContext);
+  execute(CPU::NVME__OCSSD, CPU::ERASE_INTERNAL, std::move(doErase), pContext);
 }
 
 bool OpenChannelSSD20::getLogPage(SQEntryWrapper &req, RequestFunction &func) {
@@ -1999,8 +2002,8 @@ void OpenChannelSSD20::read(SQEntryWrapper &req, RequestFunction &func) {
     pContext->slba = slba;
     pContext->nlb = nlb;
 
-    CPUContext *pCPU =
-        new CPUContext(doRead, pContext, CPU::NVME__OCSSD, CPU::READ);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__OCSSD, CPU::READ);
 
     if (req.useSGL) {
       pContext->dma =
@@ -2085,8 +2088,8 @@ void OpenChannelSSD20::write(SQEntryWrapper &req, RequestFunction &func) {
     pContext->slba = slba;
     pContext->nlb = nlb;
 
-    CPUContext *pCPU =
-        new CPUContext(doRead, pContext, CPU::NVME__OCSSD, CPU::WRITE);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::NVME__OCSSD, CPU::WRITE);
 
     if (req.useSGL) {
       pContext->dma =
@@ -2185,7 +2188,8 @@ void OpenChannelSSD20::datasetManagement(SQEntryWrapper &req,
     pContext->beginAt = getTick();
     pContext->slba = nr;
 
-    CPUContext *pCPU = new CPUContext(doTrim, pContext, CPU::NVME__OCSSD,
+    CPUContext *pCPU = new CPUContext(std::move(doTrim), pContext,
+                                      CPU::NVME__OCSSD,
                                       CPU::DATASET_MANAGEMENT);
 
     if (req.useSGL) {
@@ -2285,8 +2289,8 @@ void OpenChannelSSD20::vectorChunkRead(SQEntryWrapper &req,
     }
   };
 
-  CPUContext *pCPU = new CPUContext(doDMA, pContext, CPU::NVME__OCSSD,
-                                    CPU::VECTOR_CHUNK_WRITE);
+  CPUContext *pCPU = new CPUContext(std::move(doDMA), pContext,
+                                    CPU::NVME__OCSSD, CPU::VECTOR_CHUNK_WRITE);
 
   if (req.useSGL) {
     pContext->dma =
@@ -2393,8 +2397,8 @@ void OpenChannelSSD20::vectorChunkWrite(SQEntryWrapper &req,
     }
   };
 
-  CPUContext *pCPU = new CPUContext(doDMA, pContext, CPU::NVME__OCSSD,
-                                    CPU::VECTOR_CHUNK_WRITE);
+  CPUContext *pCPU = new CPUContext(std::move(doDMA), pContext,
+                                    CPU::NVME__OCSSD, CPU::VECTOR_CHUNK_WRITE);
 
   if (req.useSGL) {
     pContext->dma =
@@ -111,6 +111,8 @@ void Subsystem::convertUnit(Namespace *ns, uint64_t slba, uint64_t nlblk,
   uint64_t nlp;
   uint64_t off;
 
+  req.nsid = ns->getNSID();
+
   if (lbaratio == 0) {
     lbaratio = info->lbaSize / logicalPageSize;
 
@@ -389,8 +391,8 @@ void Subsystem::submitCommand(SQEntryWrapper &req, RequestFunction func) {
             delete pContext;
           };
 
-          execute(CPU::NVME__NAMESPACE, CPU::SUBMIT_COMMAND, doSubmit,
-                  pContext);
+          execute(CPU::NVME__NAMESPACE, CPU::SUBMIT_COMMAND,
+                  std::move(doSubmit), pContext);
 
           return;
         }
@@ -407,7 +409,8 @@ void Subsystem::submitCommand(SQEntryWrapper &req, RequestFunction func) {
           delete pContext;
         };
 
-        execute(CPU::NVME__NAMESPACE, CPU::SUBMIT_COMMAND, doSubmit, pContext);
+        execute(CPU::NVME__NAMESPACE, CPU::SUBMIT_COMMAND, std::move(doSubmit),
+                pContext);
 
         processed = true;
       }
@@ -445,7 +448,7 @@ void Subsystem::read(Namespace *ns, uint64_t slba, uint64_t nlblk,
 
   convertUnit(ns, slba, nlblk, *req);
 
-  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, doRead, req);
+  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, std::move(doRead), req);
 }
 
 void Subsystem::write(Namespace *ns, uint64_t slba, uint64_t nlblk,
@@ -461,13 +464,14 @@ void Subsystem::write(Namespace *ns, uint64_t slba, uint64_t nlblk,
 
   convertUnit(ns, slba, nlblk, *req);
 
-  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, doWrite, req);
+  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, std::move(doWrite), req);
 }
 
 void Subsystem::flush(Namespace *ns, DMAFunction &func, void *context) {
   Request req(func, context);
   Namespace::Information *info = ns->getInfo();
 
+  req.nsid = ns->getNSID();
   req.range.slpn = info->range.slpn;
   req.range.nlp = info->range.nlp;
   req.offset = 0;
@@ -489,7 +493,7 @@ void Subsystem::trim(Namespace *ns, uint64_t slba, uint64_t nlblk,
 
   convertUnit(ns, slba, nlblk, *req);
 
-  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, doTrim, req);
+  execute(CPU::NVME__SUBSYSTEM, CPU::CONVERT_UNIT, std::move(doTrim), req);
 }
 
 bool Subsystem::deleteSQueue(SQEntryWrapper &req, RequestFunction &func) {
@@ -1276,7 +1280,7 @@ bool Subsystem::formatNVM(SQEntryWrapper &req, RequestFunction &func) {
         delete req;
       };
 
-      execute(CPU::NVME__SUBSYSTEM, CPU::FORMAT_NVM, job, req);
+      execute(CPU::NVME__SUBSYSTEM, CPU::FORMAT_NVM, std::move(job), req);
     }
     else {
       resp.makeStatus(false, false, TYPE_GENERIC_COMMAND_STATUS,
@@ -167,7 +167,7 @@ void Device::prdtRead(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
 
   DMAContext *pContext = new DMAContext(func, context);
 
-  execute(CPU::SATA__DEVICE, CPU::PRDT_READ, doRead, pContext);
+  execute(CPU::SATA__DEVICE, CPU::PRDT_READ, std::move(doRead), pContext);
 }
 
 void Device::prdtWrite(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
@@ -203,7 +203,7 @@ void Device::prdtWrite(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
 
   DMAContext *pContext = new DMAContext(func, context);
 
-  execute(CPU::SATA__DEVICE, CPU::PRDT_WRITE, doWrite, pContext);
+  execute(CPU::SATA__DEVICE, CPU::PRDT_WRITE, std::move(doWrite), pContext);
 }
 
 void Device::convertUnit(uint64_t slba, uint64_t nlblk, Request &req) {
@@ -239,7 +239,7 @@ void Device::read(uint64_t slba, uint64_t nlb, uint8_t *buffer,
     pDisk->read(slba, nlb, buffer);
   }
 
-  execute(CPU::SATA__DEVICE, CPU::READ, doRead, req);
+  execute(CPU::SATA__DEVICE, CPU::READ, std::move(doRead), req);
 }
 
 void Device::write(uint64_t slba, uint64_t nlb, uint8_t *buffer,
@@ -259,7 +259,7 @@ void Device::write(uint64_t slba, uint64_t nlb, uint8_t *buffer,
     pDisk->write(slba, nlb, buffer);
   }
 
-  execute(CPU::SATA__DEVICE, CPU::WRITE, doWrite, req);
+  execute(CPU::SATA__DEVICE, CPU::WRITE, std::move(doWrite), req);
 }
 
 void Device::flush(DMAFunction &func, void *context) {
@@ -277,7 +277,7 @@ void Device::flush(DMAFunction &func, void *context) {
   req->offset = 0;
   req->length = totalLogicalPages * logicalPageSize;
 
-  execute(CPU::SATA__DEVICE, CPU::FLUSH, doFlush, req);
+  execute(CPU::SATA__DEVICE, CPU::FLUSH, std::move(doFlush), req);
 }
 
 void Device::_writeDMASetup(uint64_t, void *context) {
@@ -336,8 +336,8 @@ void Device::_writeDMADone(uint64_t tick, void *context) {
 
   pContext->tick = tick;
 
-  CPUContext *pCPU = new CPUContext(nandDone, pContext, CPU::SATA__DEVICE,
-                                    CPU::WRITE_DMA_DONE);
+  CPUContext *pCPU = new CPUContext(std::move(nandDone), pContext,
+                                    CPU::SATA__DEVICE, CPU::WRITE_DMA_DONE);
 
   write(pContext->slba, pContext->nlb, pContext->buffer, cpuHandler, pCPU);
 }
@@ -392,7 +392,7 @@ void Device::_readDMADone(uint64_t tick, void *context) {
     pContext->release();
   };
 
-  execute(CPU::SATA__DEVICE, CPU::READ_DMA_DONE, doSubmit, pContext);
+  execute(CPU::SATA__DEVICE, CPU::READ_DMA_DONE, std::move(doSubmit), pContext);
 }
 
 void Device::identifyDevice(CommandContext *cmd) {
@@ -631,8 +631,8 @@ void Device::readDMA(CommandContext *cmd, bool isPIO) {
   pContext->nlb = nlb;
   pContext->buffer = (uint8_t *)calloc(nlb, lbaSize);
 
-  CPUContext *pCPU =
-      new CPUContext(doRead, pContext, CPU::SATA__DEVICE, CPU::READ_DMA);
+  CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                    CPU::SATA__DEVICE, CPU::READ_DMA);
 
   read(slba, nlb, pContext->buffer, cpuHandler, pCPU);
 }
@@ -674,7 +674,7 @@ void Device::readNCQ(CommandContext *cmd) {
     pContext->release();
   };
 
-  execute(CPU::SATA__DEVICE, CPU::READ_NCQ, doSubmit, cmd);
+  execute(CPU::SATA__DEVICE, CPU::READ_NCQ, std::move(doSubmit), cmd);
 }
 
 void Device::writeDMA(CommandContext *cmd, bool isPIO) {
@@ -739,8 +739,8 @@ void Device::writeDMA(CommandContext *cmd, bool isPIO) {
   pContext->nlb = nlb;
   pContext->buffer = (uint8_t *)calloc(nlb, lbaSize);
 
-  CPUContext *pCPU =
-      new CPUContext(doRead, pContext, CPU::SATA__DEVICE, CPU::WRITE_DMA);
+  CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                    CPU::SATA__DEVICE, CPU::WRITE_DMA);
 
   prdtRead(pContext->cmd->prdt, pContext->cmd->prdtLength, nlb * lbaSize,
            pContext->buffer, cpuHandler, pCPU);
@@ -791,7 +791,7 @@ void Device::writeNCQ(CommandContext *cmd) {
   wrapper->cmd = cmd;
   wrapper->ncq = pContext;
 
-  execute(CPU::SATA__DEVICE, CPU::WRITE_NCQ, doSubmit, wrapper);
+  execute(CPU::SATA__DEVICE, CPU::WRITE_NCQ, std::move(doSubmit), wrapper);
 }
 
 void Device::flushCache(CommandContext *cmd) {
@@ -366,8 +366,8 @@ void HBA::handleRequest() {
     uint64_t addr =
         port.commandListBaseAddress + pContext->idx * sizeof(CommandHeader);
 
-    CPUContext *pCPU = new CPUContext(doRead, pContext, CPU::SATA__DEVICE,
-                                      CPU::SUBMIT_COMMAND);
+    CPUContext *pCPU = new CPUContext(std::move(doRead), pContext,
+                                      CPU::SATA__DEVICE, CPU::SUBMIT_COMMAND);
 
     pHostDMA->dmaRead(addr, sizeof(CommandHeader), pContext->header.data,
                       cpuHandler, pCPU);
@@ -836,7 +836,7 @@ void Device::prdtRead(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
 
   DMAContext *pContext = new DMAContext(func, context);
 
-  execute(CPU::UFS__DEVICE, CPU::PRDT_READ, doRead, pContext);
+  execute(CPU::UFS__DEVICE, CPU::PRDT_READ, std::move(doRead), pContext);
 }
 
 void Device::prdtWrite(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
@@ -872,7 +872,7 @@ void Device::prdtWrite(uint8_t *prdt, uint32_t prdtLength, uint32_t length,
 
   DMAContext *pContext = new DMAContext(func, context);
 
-  execute(CPU::UFS__DEVICE, CPU::PRDT_WRITE, doWrite, pContext);
+  execute(CPU::UFS__DEVICE, CPU::PRDT_WRITE, std::move(doWrite), pContext);
 }
 
 void Device::convertUnit(uint64_t slba, uint64_t nlblk, Request &req) {
@@ -909,7 +909,7 @@ void Device::read(uint64_t slba, uint64_t nlb, uint8_t *buffer,
     pDisk->read(slba, nlb, buffer);
   }
 
-  execute(CPU::UFS__DEVICE, CPU::READ, doRead, req);
+  execute(CPU::UFS__DEVICE, CPU::READ, std::move(doRead), req);
 }
 
 void Device::write(uint64_t slba, uint64_t nlb, uint8_t *buffer,
@@ -929,7 +929,7 @@ void Device::write(uint64_t slba, uint64_t nlb, uint8_t *buffer,
     pDisk->write(slba, nlb, buffer);
   }
 
-  execute(CPU::UFS__DEVICE, CPU::WRITE, doWrite, req);
+  execute(CPU::UFS__DEVICE, CPU::WRITE, std::move(doWrite), req);
 }
 
 void Device::flush(DMAFunction &func, void *context) {
@@ -947,7 +947,7 @@ void Device::flush(DMAFunction &func, void *context) {
   req->offset = 0;
   req->length = totalLogicalPages * logicalPageSize;
 
-  execute(CPU::UFS__DEVICE, CPU::FLUSH, doFlush, req);
+  execute(CPU::UFS__DEVICE, CPU::FLUSH, std::move(doFlush), req);
 }
 
 void Device::getStatList(std::vector<Stats> &list, std::string prefix) {
@@ -283,14 +283,16 @@ void Host::processUTPCommand(UTPTransferReqDesc &req, UTP_TRANSFER_CMD cmd,
             (UPIUQueryReq *)pContext->transferReqUPIU,
             (UPIUQueryResp *)pContext->transferRespUPIU);
 
-        execute(CPU::UFS__DEVICE, CPU::PROCESS_QUERY_COMMAND, done, context);
+        execute(CPU::UFS__DEVICE, CPU::PROCESS_QUERY_COMMAND, std::move(done),
+                context);
 
         break;
       case OPCODE_COMMAND:
         pContext->transferRespUPIU = getUPIU(OPCODE_RESPONSE);
 
         {
-          CPUContext *pCPU = new CPUContext(done, context, CPU::UFS__DEVICE,
+          CPUContext *pCPU = new CPUContext(std::move(done), context,
+                                            CPU::UFS__DEVICE,
                                             CPU::PROCESS_COMMAND);
 
           pDevice->processCommand(
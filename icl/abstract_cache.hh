@@ -34,6 +34,7 @@ typedef struct _Line {
   uint64_t insertedAt;
   bool dirty;
   bool valid;
+  Bitset validSector;  // Sectors holding up-to-date data
 
   _Line();
   _Line(uint64_t, bool);
@@ -37,6 +37,17 @@ const char NAME_PREFETCH_COUNT[] = "ReadPrefetchCount";
 const char NAME_PREFETCH_RATIO[] = "ReadPrefetchRatio";
 const char NAME_PREFETCH_MODE[] = "ReadPrefetchMode";
 const char NAME_CACHE_LATENCY[] = "CacheLatency";
+const char NAME_USE_METADATA_DRAM[] = "EnableMetadataDRAM";
+const char NAME_TAG_CACHE_SIZE[] = "TagCacheSize";
+const char NAME_TAG_CACHE_LATENCY[] = "TagCacheLatency";
+const char NAME_USE_READ_ADMISSION[] = "EnableReadAdmission";
+const char NAME_USE_WRITE_ADMISSION[] = "EnableWriteAdmission";
+const char NAME_ADMISSION_BYPASS_SIZE[] = "AdmissionBypassSize";
+const char NAME_ADMISSION_SKETCH_SIZE[] = "AdmissionSketchSize";
+const char NAME_PARTITION_MODE[] = "CachePartitionMode";
+const char NAME_PARTITION_COUNT[] = "CachePartitionCount";
+const char NAME_PARTITION_INTERVAL[] = "CachePartitionInterval";
+const char NAME_PARTITION_RATIO[] = "CachePartitionRatio";
 
 Config::Config() {
   readCaching = false;
@@ -50,6 +61,16 @@ Config::Config() {
   prefetchMode = MODE_ALL;
   evictMode = MODE_ALL;
   cacheLatency = 10;
+  metadataDRAM = false;
+  tagCacheSize = 0;
+  tagCacheLatency = 500;
+  readAdmission = false;
+  writeAdmission = false;
+  bypassSize = 4194304;
+  sketchSize = 0;
+  partitionMode = PARTITION_NONE;
+  partitionCount = 1;
+  partitionInterval = 10000;
 }
 
 bool Config::setConfig(const char *name, const char *value) {
@@ -88,6 +109,45 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_CACHE_LATENCY)) {
     cacheLatency = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_USE_METADATA_DRAM)) {
+    metadataDRAM = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_TAG_CACHE_SIZE)) {
+    tagCacheSize = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_TAG_CACHE_LATENCY)) {
+    tagCacheLatency = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_USE_READ_ADMISSION)) {
+    readAdmission = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_USE_WRITE_ADMISSION)) {
+    writeAdmission = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_ADMISSION_BYPASS_SIZE)) {
+    bypassSize = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_ADMISSION_SKETCH_SIZE)) {
+    sketchSize = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_PARTITION_MODE)) {
+    partitionMode = (PARTITION_MODE)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_PARTITION_COUNT)) {
+    partitionCount = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_PARTITION_INTERVAL)) {
+    partitionInterval = strtoul(value, nullptr, 10);
+  }
+  else if (strncmp(name, NAME_PARTITION_RATIO, strlen(NAME_PARTITION_RATIO)) ==
+           0) {
+    uint32_t index =
+        (uint32_t)strtoul(name + strlen(NAME_PARTITION_RATIO), nullptr, 10);
+
+    if (index > 0) {
+      partitionRatio[index] = strtof(value, nullptr);
+    }
+  }
   else {
     ret = false;
   }
@@ -102,6 +162,29 @@ void Config::update() {
   if (prefetchRatio <= 0.f) {
     panic("Invalid ReadPrefetchRatio");
   }
+  if (partitionMode > PARTITION_UTILITY) {
+    panic("Invalid CachePartitionMode");
+  }
+  if (partitionCount == 0) {
+    panic("Invalid CachePartitionCount");
+  }
+  if (partitionMode == PARTITION_UTILITY && partitionInterval == 0) {
+    panic("Invalid CachePartitionInterval");
+  }
+
+  float sum = 0.f;
+
+  for (auto &iter : partitionRatio) {
+    if (iter.second < 0.f) {
+      panic("Invalid CachePartitionRatio%u", iter.first);
+    }
+
+    sum += iter.second;
+  }
+
+  if (sum > 1.f) {
+    panic("Sum of CachePartitionRatio exceeds 1");
+  }
 }
 
 int64_t Config::readInt(uint32_t idx) {
@@ -117,6 +200,9 @@ int64_t Config::readInt(uint32_t idx) {
     case ICL_EVICT_GRANULARITY:
       ret = evictMode;
       break;
+    case ICL_PARTITION_MODE:
+      ret = partitionMode;
+      break;
   }
 
   return ret;
@@ -138,6 +224,24 @@ uint64_t Config::readUint(uint32_t idx) {
     case ICL_CACHE_LATENCY:
       ret = cacheLatency;
       break;
+    case ICL_TAG_CACHE_SIZE:
+      ret = tagCacheSize;
+      break;
+    case ICL_TAG_CACHE_LATENCY:
+      ret = tagCacheLatency;
+      break;
+    case ICL_ADMISSION_BYPASS_SIZE:
+      ret = bypassSize;
+      break;
+    case ICL_ADMISSION_SKETCH_SIZE:
+      ret = sketchSize;
+      break;
+    case ICL_PARTITION_COUNT:
+      ret = partitionCount;
+      break;
+    case ICL_PARTITION_INTERVAL:
+      ret = partitionInterval;
+      break;
   }
 
   return ret;
@@ -152,6 +256,14 @@ float Config::readFloat(uint32_t idx) {
       break;
   }
 
+  if (idx >= ICL_PARTITION_RATIO) {
+    auto find = partitionRatio.find(idx - ICL_PARTITION_RATIO);
+
+    if (find != partitionRatio.end()) {
+      ret = find->second;
+    }
+  }
+
   return ret;
 }
 
@@ -168,6 +280,15 @@ bool Config::readBoolean(uint32_t idx) {
     case ICL_USE_READ_PREFETCH:
       ret = readPrefetch;
       break;
+    case ICL_USE_METADATA_DRAM:
+      ret = metadataDRAM;
+      break;
+    case ICL_USE_READ_ADMISSION:
+      ret = readAdmission;
+      break;
+    case ICL_USE_WRITE_ADMISSION:
+      ret = writeAdmission;
+      break;
   }
 
   return ret;
@@ -20,6 +20,8 @@
 #ifndef __ICL_CONFIG__
 #define __ICL_CONFIG__
 
+#include <unordered_map>
+
 #include "sim/base_config.hh"
 
 namespace SimpleSSD {
@@ -39,6 +41,21 @@ typedef enum {
   ICL_CACHE_SIZE,
   ICL_WAY_SIZE,
   ICL_CACHE_LATENCY,
+  ICL_USE_METADATA_DRAM,
+  ICL_TAG_CACHE_SIZE,
+  ICL_TAG_CACHE_LATENCY,
+
+  /* Cache admission */
+  ICL_USE_READ_ADMISSION,
+  ICL_USE_WRITE_ADMISSION,
+  ICL_ADMISSION_BYPASS_SIZE,
+  ICL_ADMISSION_SKETCH_SIZE,
+
+  /* Namespace partitioning */
+  ICL_PARTITION_MODE,
+  ICL_PARTITION_COUNT,
+  ICL_PARTITION_INTERVAL,
+  ICL_PARTITION_RATIO,  // Should be last item
 } ICL_CONFIG;
 
 typedef enum {
@@ -54,6 +71,12 @@ typedef enum {
 
 typedef PREFETCH_MODE EVICT_MODE;
 
+typedef enum {
+  PARTITION_NONE,     //!< All namespaces share whole cache
+  PARTITION_STATIC,   //!< Each namespace has fixed portion of ways
+  PARTITION_UTILITY,  //!< Ways are re-distributed by measured utility
+} PARTITION_MODE;
+
 class Config : public BaseConfig {
  private:
   bool readCaching;            //!< Default: false
@@ -67,6 +90,18 @@ class Config : public BaseConfig {
   PREFETCH_MODE prefetchMode;  //!< Default: MODE_ALL
   EVICT_MODE evictMode;        //!< Default: MODE_ALL
   uint64_t cacheLatency;       //!< Default:
+  bool metadataDRAM;           //!< Default: false
+  uint64_t tagCacheSize;       //!< Default: 0
+  uint64_t tagCacheLatency;    //!< Default: 500 (0.5ns)
+  bool readAdmission;          //!< Default: false
+  bool writeAdmission;         //!< Default: false
+  uint64_t bypassSize;         //!< Default: 4194304 (4MiB)
+  uint64_t sketchSize;         //!< Default: 0
+
+  PARTITION_MODE partitionMode;  //!< Default: PARTITION_NONE
+  uint64_t partitionCount;       //!< Default: 1
+  uint64_t partitionInterval;    //!< Default: 10000
+  std::unordered_map<uint32_t, float> partitionRatio;
 
  public:
   Config();
@@ -29,6 +29,95 @@ namespace SimpleSSD {
 
 namespace ICL {
 
+#define UTILITY_MONITOR_SETS 32
+
+// Cache metadata layout in DRAM
+// Metadata of one set is stored contiguously in way order, and each entry
+// holds tag, insertedAt, lastAccessed and flags (valid, dirty).
+#define META_ENTRY_SIZE 32
+
+// Granularity of valid bitmap in cache line
+#define SECTOR_SIZE 512
+
+// Frequency sketch for cache admission
+#define SKETCH_DEPTH 4
+#define SKETCH_MAX_COUNT 15
+#define SKETCH_SAMPLE_FACTOR 10
+
+static const uint64_t sketchSeed[SKETCH_DEPTH] = {
+    0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+    0xD6E8FEB86659FD93ull};
+
+GenericCache::Partition::Partition() : wayBegin(0), wayEnd(0) {
+  memset(request, 0, sizeof(request));
+  memset(cache, 0, sizeof(cache));
+}
+
+GenericCache::Admission::Admission()
+    : enabled(false),
+      nextAddress(std::numeric_limits<uint64_t>::max()),
+      streamSize(0) {}
+
+GenericCache::FrequencySketch::FrequencySketch()
+    : mask(0), additions(0), sampleSize(0) {}
+
+void GenericCache::FrequencySketch::init(uint64_t size) {
+  uint64_t width = 1;
+
+  if (size == 0) {
+    return;
+  }
+
+  while (width < size) {
+    width <<= 1;
+  }
+
+  mask = (uint32_t)(width - 1);
+  sampleSize = width * SKETCH_SAMPLE_FACTOR;
+  table.resize(width * SKETCH_DEPTH, 0);
+}
+
+uint32_t GenericCache::FrequencySketch::index(uint64_t lca, uint32_t row) {
+  uint64_t hash = (lca + sketchSeed[row]) * sketchSeed[row];
+
+  hash ^= hash >> 32;
+
+  return row * (mask + 1) + (uint32_t)(hash & mask);
+}
+
+void GenericCache::FrequencySketch::increment(uint64_t lca) {
+  if (table.empty()) {
+    return;
+  }
+
+  for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+    uint8_t &counter = table[index(lca, row)];
+
+    if (counter < SKETCH_MAX_COUNT) {
+      counter++;
+    }
+  }
+
+  // Aging: halve all counters so old popularity fades out
+  if (++additions >= sampleSize) {
+    for (auto &iter : table) {
+      iter >>= 1;
+    }
+
+    additions /= 2;
+  }
+}
+
+uint8_t GenericCache::FrequencySketch::estimate(uint64_t lca) {
+  uint8_t ret = SKETCH_MAX_COUNT;
+
+  for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+    ret = MIN(ret, table[index(lca, row)]);
+  }
+
+  return ret;
+}
+
 GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
     : AbstractCache(c, f, d),
       superPageSize(f->getInfo()->pageSize),
@@ -57,6 +146,22 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
     lineCountInMaxIO = parallelIO;
   }
 
+  sectorCount = MAX(lineSize / SECTOR_SIZE, 1);
+
+  partitionMode = PARTITION_NONE;
+  partitionAccessCount = 0;
+  useMetadataDRAM = false;
+  tagCacheSets = 0;
+  tagCacheLatency = 0;
+  bypassSize = 0;
+
+  // Buffer holds one maximum parallel I/O
+  bufferSize = (uint64_t)lineCountInMaxIO * lineSize;
+  bufferOffset = 0;
+  bufferRegion = pDRAM->addRegion("icl.buffer", bufferSize);
+  dataRegion = 0;
+  metadataRegion = 0;
+
   if (!useReadCaching && !useWriteCaching) {
     return;
   }
@@ -82,6 +187,51 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
 
   for (uint32_t i = 0; i < setSize; i++) {
     cacheData[i] = new Line[waySize]();
+
+    for (uint32_t j = 0; j < waySize; j++) {
+      cacheData[i][j].validSector = Bitset(sectorCount);
+    }
+  }
+
+  dataRegion =
+      pDRAM->addRegion("icl.data", (uint64_t)setSize * waySize * lineSize);
+
+  // Metadata access
+  useMetadataDRAM = conf.readBoolean(CONFIG_ICL, ICL_USE_METADATA_DRAM);
+
+  if (useMetadataDRAM) {
+    tagCacheSets = conf.readUint(CONFIG_ICL, ICL_TAG_CACHE_SIZE) /
+                   ((uint64_t)waySize * META_ENTRY_SIZE);
+    tagCacheLatency = conf.readUint(CONFIG_ICL, ICL_TAG_CACHE_LATENCY);
+
+    if (conf.readUint(CONFIG_ICL, ICL_TAG_CACHE_SIZE) > 0 &&
+        tagCacheSets == 0) {
+      warn("TagCacheSize is smaller than metadata of one set. Disabled.");
+    }
+
+    debugprint(LOG_ICL_GENERIC_CACHE,
+               "CREATE  | Metadata %" PRIu64 " bytes | Tag cache %u sets",
+               (uint64_t)setSize * waySize * META_ENTRY_SIZE, tagCacheSets);
+
+    metadataRegion = pDRAM->addRegion(
+        "icl.metadata", (uint64_t)setSize * waySize * META_ENTRY_SIZE);
+  }
+
+  // Cache admission
+  admission[0].enabled =
+      useReadCaching && conf.readBoolean(CONFIG_ICL, ICL_USE_READ_ADMISSION);
+  admission[1].enabled =
+      useWriteCaching && conf.readBoolean(CONFIG_ICL, ICL_USE_WRITE_ADMISSION);
+  bypassSize = conf.readUint(CONFIG_ICL, ICL_ADMISSION_BYPASS_SIZE);
+
+  if (admission[0].enabled || admission[1].enabled) {
+    sketch.init(conf.readUint(CONFIG_ICL, ICL_ADMISSION_SKETCH_SIZE));
+
+    debugprint(LOG_ICL_GENERIC_CACHE,
+               "CREATE  | Admission R %u W %u | Bypass %" PRIu64
+               " bytes | Sketch %u",
+               admission[0].enabled, admission[1].enabled, bypassSize,
+               (uint32_t)sketch.table.size() / SKETCH_DEPTH);
   }
 
   evictData.resize(lineCountInSuperPage);
@@ -92,6 +242,74 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
 
   prefetchTrigger = std::numeric_limits<uint64_t>::max();
 
+  // Namespace partitioning
+  std::vector<uint32_t> ways(1, waySize);
+
+  partitionMode = (PARTITION_MODE)conf.readInt(CONFIG_ICL, ICL_PARTITION_MODE);
+  partitionInterval = conf.readUint(CONFIG_ICL, ICL_PARTITION_INTERVAL);
+
+  if (partitionMode != PARTITION_NONE) {
+    uint32_t partitionCount = conf.readUint(CONFIG_ICL, ICL_PARTITION_COUNT);
+    uint32_t assigned = 0;
+    uint32_t unassigned = 0;
+    uint32_t remain;
+
+    if (waySize < partitionCount) {
+      panic("Cache way size is smaller than partition count");
+    }
+
+    ways.resize(partitionCount);
+
+    // Namespaces with ratio get their portion, others share remaining ways
+    for (uint32_t i = 0; i < partitionCount; i++) {
+      float ratio = conf.readFloat(CONFIG_ICL, ICL_PARTITION_RATIO + i + 1);
+
+      if (ratio > 0.f) {
+        ways[i] = MAX((uint32_t)(ratio * waySize), 1);
+        assigned += ways[i];
+      }
+      else {
+        ways[i] = 0;
+        unassigned++;
+      }
+    }
+
+    if (assigned + unassigned > waySize) {
+      panic("Not enough cache ways to satisfy CachePartitionRatio");
+    }
+
+    remain = waySize - assigned;
+
+    for (uint32_t i = 0; i < partitionCount; i++) {
+      if (ways[i] == 0) {
+        ways[i] = remain / unassigned;
+        remain -= ways[i];
+        unassigned--;
+      }
+    }
+
+    // Ways left by rounding
+    for (uint32_t i = 0; remain > 0; i = (i + 1) % partitionCount) {
+      ways[i]++;
+      remain--;
+    }
+  }
+
+  partitions.resize(ways.size());
+  setPartitionWays(ways);
+
+  if (partitionMode == PARTITION_UTILITY) {
+    monitorStride = MAX(setSize / UTILITY_MONITOR_SETS, 1);
+
+    for (auto &iter : partitions) {
+      iter.hitCounter.resize(waySize, 0);
+      iter.shadowTags.resize((setSize - 1) / monitorStride + 1);
+    }
+  }
+
+  debugprint(LOG_ICL_GENERIC_CACHE, "CREATE  | Partition mode %u | Count %u",
+             partitionMode, (uint32_t)partitions.size());
+
   evictMode = (EVICT_MODE)conf.readInt(CONFIG_ICL, ICL_EVICT_GRANULARITY);
   prefetchMode =
       (PREFETCH_MODE)conf.readInt(CONFIG_ICL, ICL_PREFETCH_GRANULARITY);
@@ -101,8 +319,16 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
 
   switch (policy) {
     case POLICY_RANDOM:
-      evictFunction = [this](uint32_t, uint64_t &) -> uint32_t {
-        return dist(gen);
+      evictFunction = [this](uint32_t, uint32_t partIdx,
+                             uint64_t &) -> uint32_t {
+        auto &part = partitions[partIdx];
+
+        if (part.wayEnd - part.wayBegin == waySize) {
+          return dist(gen);
+        }
+
+        return std::uniform_int_distribution<uint32_t>(part.wayBegin,
+                                                       part.wayEnd - 1)(gen);
       };
       compareFunction = [this](Line *a, Line *b) -> Line * {
         if (a && b) {
@@ -118,15 +344,15 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
 
       break;
     case POLICY_FIFO:
-      evictFunction = [this](uint32_t setIdx, uint64_t &tick) -> uint32_t {
-        uint32_t wayIdx = 0;
+      evictFunction = [this](uint32_t setIdx, uint32_t partIdx,
+                             uint64_t &tick) -> uint32_t {
+        auto &part = partitions[partIdx];
+        uint32_t wayIdx = part.wayBegin;
         uint64_t min = std::numeric_limits<uint64_t>::max();
 
-        for (uint32_t i = 0; i < waySize; i++) {
-          tick += getCacheLatency() * 8;
-          // pDRAM->read(MAKE_META_ADDR(setIdx, i, offsetof(Line, insertedAt)),
-          // 8, tick);
+        readMetadata(setIdx, part.wayBegin, part.wayEnd, tick);
 
+        for (uint32_t i = part.wayBegin; i < part.wayEnd; i++) {
           if (cacheData[setIdx][i].insertedAt < min) {
             min = cacheData[setIdx][i].insertedAt;
             wayIdx = i;
@@ -154,15 +380,15 @@ GenericCache::GenericCache(ConfigReader &c, FTL::FTL *f, DRAM::AbstractDRAM *d)
 
       break;
     case POLICY_LEAST_RECENTLY_USED:
-      evictFunction = [this](uint32_t setIdx, uint64_t &tick) -> uint32_t {
-        uint32_t wayIdx = 0;
+      evictFunction = [this](uint32_t setIdx, uint32_t partIdx,
+                             uint64_t &tick) -> uint32_t {
+        auto &part = partitions[partIdx];
+        uint32_t wayIdx = part.wayBegin;
         uint64_t min = std::numeric_limits<uint64_t>::max();
 
-        for (uint32_t i = 0; i < waySize; i++) {
-          tick += getCacheLatency() * 8;
-          // pDRAM->read(MAKE_META_ADDR(setIdx, i, offsetof(Line,
-          // lastAccessed)), 8, tick);
+        readMetadata(setIdx, part.wayBegin, part.wayEnd, tick);
 
+        for (uint32_t i = part.wayBegin; i < part.wayEnd; i++) {
           if (cacheData[setIdx][i].lastAccessed < min) {
             min = cacheData[setIdx][i].lastAccessed;
             wayIdx = i;
@@ -219,6 +445,73 @@ uint64_t GenericCache::getCacheLatency() {
   return (core == 0) ? 0 : latency / core;
 }
 
+// Read metadata of [wayBegin, wayEnd) ways in one set
+void GenericCache::readMetadata(uint32_t setIdx, uint32_t wayBegin,
+                                uint32_t wayEnd, uint64_t &tick) {
+  uint32_t ways = wayEnd - wayBegin;
+
+  if (!useMetadataDRAM) {
+    tick += getCacheLatency() * ways * 8;
+
+    return;
+  }
+
+  // Tag cache holds metadata of whole set
+  if (tagCacheSets > 0) {
+    auto iter = tagCacheMap.find(setIdx);
+
+    if (iter != tagCacheMap.end()) {
+      tagCacheLRU.splice(tagCacheLRU.begin(), tagCacheLRU, iter->second);
+      tick += tagCacheLatency;
+      stat.tagCache[0]++;
+
+      return;
+    }
+
+    if (tagCacheLRU.size() == tagCacheSets) {
+      tagCacheMap.erase(tagCacheLRU.back());
+      tagCacheLRU.pop_back();
+    }
+
+    tagCacheLRU.push_front(setIdx);
+    tagCacheMap.emplace(setIdx, tagCacheLRU.begin());
+    stat.tagCache[1]++;
+
+    wayBegin = 0;
+    ways = waySize;
+  }
+
+  // Contiguous entries are fetched in one DRAM access
+  pDRAM->read(pDRAM->getAddress(metadataRegion,
+                                ((uint64_t)setIdx * waySize + wayBegin) *
+                                    META_ENTRY_SIZE),
+              (uint64_t)ways * META_ENTRY_SIZE, tick);
+}
+
+void GenericCache::readAllMetadata(uint64_t &tick) {
+  if (!useMetadataDRAM) {
+    tick += getCacheLatency() * setSize * waySize * 8;
+  }
+  else {
+    pDRAM->read(pDRAM->getAddress(metadataRegion, 0),
+                (uint64_t)setSize * waySize * META_ENTRY_SIZE, tick);
+  }
+}
+
+void *GenericCache::getLineAddress(uint32_t setIdx, uint32_t wayIdx) {
+  return pDRAM->getAddress(dataRegion,
+                           ((uint64_t)setIdx * waySize + wayIdx) * lineSize);
+}
+
+// Buffer is used as ring, because uncached data is not kept after I/O
+void *GenericCache::getBufferAddress(uint64_t length) {
+  void *ret = pDRAM->getAddress(bufferRegion, bufferOffset);
+
+  bufferOffset = (bufferOffset + length) % bufferSize;
+
+  return ret;
+}
+
 uint32_t GenericCache::calcSetIndex(uint64_t lca) {
   return lca % setSize;
 }
@@ -230,17 +523,106 @@ void GenericCache::calcIOPosition(uint64_t lca, uint32_t &row, uint32_t &col) {
   col = tmp / lineCountInSuperPage;
 }
 
-uint32_t GenericCache::getEmptyWay(uint32_t setIdx, uint64_t &tick) {
+uint32_t GenericCache::getPartitionIndex(uint32_t nsid) {
+  uint32_t count = partitions.size();
+
+  // Namespaces beyond partition count share the last partition
+  if (count <= 1 || nsid == 0) {
+    return 0;
+  }
+
+  return MIN(nsid, count) - 1;
+}
+
+void GenericCache::setPartitionWays(std::vector<uint32_t> &ways) {
+  uint32_t wayIdx = 0;
+
+  for (uint32_t i = 0; i < partitions.size(); i++) {
+    partitions[i].wayBegin = wayIdx;
+    wayIdx += ways[i];
+    partitions[i].wayEnd = wayIdx;
+
+    debugprint(LOG_ICL_GENERIC_CACHE, "PART  | Partition %u | Way %u - %u", i,
+               partitions[i].wayBegin, partitions[i].wayEnd);
+  }
+}
+
+void GenericCache::updateMonitor(uint32_t partIdx, uint64_t lca) {
+  uint32_t setIdx = calcSetIndex(lca);
+
+  // Only sampled sets are monitored
+  if (setIdx % monitorStride == 0) {
+    auto &part = partitions[partIdx];
+    auto &tags = part.shadowTags[setIdx / monitorStride];
+    auto iter = std::find(tags.begin(), tags.end(), lca);
+
+    // Shadow tags are sorted in MRU order
+    if (iter != tags.end()) {
+      part.hitCounter[iter - tags.begin()]++;
+      tags.erase(iter);
+    }
+    else if (tags.size() == waySize) {
+      tags.pop_back();
+    }
+
+    tags.insert(tags.begin(), lca);
+  }
+
+  if (++partitionAccessCount >= partitionInterval) {
+    partitionAccessCount = 0;
+
+    updatePartition();
+  }
+}
+
+// Greedy utility-based partitioning (one way at a time)
+void GenericCache::updatePartition() {
+  std::vector<uint32_t> ways(partitions.size(), 1);
+
+  for (uint32_t remain = waySize - partitions.size(); remain > 0; remain--) {
+    uint32_t best = 0;
+    uint64_t maxGain = 0;
+
+    for (uint32_t i = 0; i < partitions.size(); i++) {
+      uint64_t gain = partitions[i].hitCounter[ways[i]];
+
+      if (gain > maxGain || (gain == maxGain && ways[i] < ways[best])) {
+        maxGain = gain;
+        best = i;
+      }
+    }
+
+    ways[best]++;
+  }
+
+  setPartitionWays(ways);
+
+  // Decay old history
+  for (auto &iter : partitions) {
+    for (auto &counter : iter.hitCounter) {
+      counter /= 2;
+    }
+  }
+}
+
+uint32_t GenericCache::getEmptyWay(uint32_t setIdx, uint32_t partIdx,
+                                   uint64_t &tick) {
+  auto &part = partitions[partIdx];
   uint32_t retIdx = waySize;
   uint64_t minInsertedAt = std::numeric_limits<uint64_t>::max();
 
-  for (uint32_t wayIdx = 0; wayIdx < waySize; wayIdx++) {
+  if (useMetadataDRAM) {
+    readMetadata(setIdx, part.wayBegin, part.wayEnd, tick);
+  }
+
+  for (uint32_t wayIdx = part.wayBegin; wayIdx < part.wayEnd; wayIdx++) {
     Line &line = cacheData[setIdx][wayIdx];
 
     if (!line.valid) {
-      tick += getCacheLatency() * 8;
-      // pDRAM->read(MAKE_META_ADDR(setIdx, wayIdx, offsetof(Line, insertedAt)),
-      // 8, tick);
+      // Without metadata DRAM, only invalid ways are charged
+      if (!useMetadataDRAM) {
+        tick += getCacheLatency() * 8;
+      }
 
       if (minInsertedAt > line.insertedAt) {
         minInsertedAt = line.insertedAt;
@@ -259,15 +641,14 @@ uint32_t GenericCache::getValidWay(uint64_t lca, uint64_t &tick) {
   for (wayIdx = 0; wayIdx < waySize; wayIdx++) {
     Line &line = cacheData[setIdx][wayIdx];
 
-    tick += getCacheLatency() * 8;
-    // pDRAM->read(MAKE_META_ADDR(setIdx, wayIdx, offsetof(Line, tag)), 8,
-    // tick);
-
     if (line.valid && line.tag == lca) {
       break;
     }
   }
 
+  // Ways are compared in order until tag matches
+  readMetadata(setIdx, 0, MIN(wayIdx + 1, waySize), tick);
+
   return wayIdx;
 }
 
@@ -302,6 +683,90 @@ void GenericCache::checkSequential(Request &req, SequentialDetect &data) {
   data.lastRequest = req;
 }
 
+// True when request continues sequential stream larger than bypassSize
+bool GenericCache::checkStream(Request &req, Admission &data) {
+  uint64_t address = req.range.slpn * lineSize + req.offset;
+
+  if (address == data.nextAddress) {
+    data.streamSize += req.length;
+  }
+  else {
+    data.streamSize = req.length;
+  }
+
+  data.nextAddress = address + req.length;
+
+  return bypassSize > 0 && data.streamSize > bypassSize;
+}
+
+// True when line can be allocated without evicting more popular line
+bool GenericCache::checkAdmission(uint64_t lca, uint32_t partIdx) {
+  uint32_t setIdx = calcSetIndex(lca);
+  auto &part = partitions[partIdx];
+  Line *pVictim = nullptr;
+
+  if (sketch.table.empty()) {
+    return true;
+  }
+
+  // Metadata of this set is already fetched by getValidWay
+  for (uint32_t wayIdx = part.wayBegin; wayIdx < part.wayEnd; wayIdx++) {
+    Line *pLine = cacheData[setIdx] + wayIdx;
+
+    if (!pLine->valid) {
+      return true;
+    }
+
+    pVictim = compareFunction(pVictim, pLine);
+  }
+
+  return sketch.estimate(lca) > sketch.estimate(pVictim->tag);
+}
+
+// Line tag should be valid before calling this function
+void GenericCache::setDirty(Line *pLine, bool dirty) {
+  if (pLine->dirty) {
+    dirtyLines.erase(pLine->tag);
+  }
+
+  pLine->dirty = dirty;
+
+  if (dirty) {
+    dirtyLines[pLine->tag] = pLine;
+  }
+}
+
+void GenericCache::invalidate(Line *pLine) {
+  setDirty(pLine, false);
+
+  pLine->valid = false;
+  pLine->validSector.reset();
+}
+
+void GenericCache::setValidSector(Line *pLine, uint64_t offset,
+                                  uint64_t length) {
+  uint32_t begin = offset / SECTOR_SIZE;
+  uint32_t end = MIN(DIVCEIL(offset + length, SECTOR_SIZE), sectorCount);
+
+  for (uint32_t i = begin; i < end; i++) {
+    pLine->validSector.set(i);
+  }
+}
+
+bool GenericCache::checkValidSector(Line *pLine, uint64_t offset,
+                                    uint64_t length) {
+  uint32_t begin = offset / SECTOR_SIZE;
+  uint32_t end = MIN(DIVCEIL(offset + length, SECTOR_SIZE), sectorCount);
+
+  for (uint32_t i = begin; i < end; i++) {
+    if (!pLine->validSector.test(i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void GenericCache::evictCache(uint64_t tick, bool flush) {
   FTL::Request reqInternal(lineCountInSuperPage);
   uint64_t beginAt;
@@ -321,18 +786,31 @@ void GenericCache::evictCache(uint64_t tick, bool flush) {
         reqInternal.lpn = evictData[row][col]->tag / lineCountInSuperPage;
         reqInternal.ioFlag.reset();
         reqInternal.ioFlag.set(row);
+        reqInternal.partialFlag.reset();
+
+        // FTL merges old data only when some sectors were never written
+        if (evictData[row][col]->validSector.all()) {
+          stat.fullDestage++;
+        }
+        else {
+          reqInternal.partialFlag.set(row);
+
+          stat.partialDestage++;
+        }
 
         pFTL->write(reqInternal, beginAt);
       }
 
+      setDirty(evictData[row][col], false);
+
       if (flush) {
         evictData[row][col]->valid = false;
         evictData[row][col]->tag = 0;
+        evictData[row][col]->validSector.reset();
       }
 
       evictData[row][col]->insertedAt = beginAt;
       evictData[row][col]->lastAccessed = beginAt;
-      evictData[row][col]->dirty = false;
       evictData[row][col] = nullptr;
 
       finishedAt = MAX(finishedAt, beginAt);
@@ -347,6 +825,7 @@ void GenericCache::evictCache(uint64_t tick, bool flush) {
 // True when hit
 bool GenericCache::read(Request &req, uint64_t &tick) {
   bool ret = false;
+  uint32_t partIdx = getPartitionIndex(req.nsid);
 
   debugprint(LOG_ICL_GENERIC_CACHE,
              "READ  | REQ %7u-%-4u | LCA %" PRIu64 " | SIZE %" PRIu64,
@@ -356,11 +835,21 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
     uint32_t setIdx = calcSetIndex(req.range.slpn);
     uint32_t wayIdx;
     uint64_t arrived = tick;
+    bool stream = false;
 
     if (useReadPrefetch) {
       checkSequential(req, readDetect);
     }
 
+    if (admission[0].enabled) {
+      sketch.increment(req.range.slpn);
+      stream = checkStream(req, admission[0]);
+    }
+
+    if (partitionMode == PARTITION_UTILITY) {
+      updateMonitor(partIdx, req.range.slpn);
+    }
+
     wayIdx = getValidWay(req.range.slpn, tick);
 
     // Do we have valid data?
@@ -372,11 +861,25 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
         tick = cacheData[setIdx][wayIdx].insertedAt;
       }
 
+      // Requested sectors were never written to cache, so they must come
+      // from NVM. FTL skips read when LPN has no data.
+      if (!checkValidSector(cacheData[setIdx] + wayIdx, req.offset,
+                            req.length)) {
+        FTL::Request reqInternal(lineCountInSuperPage, req);
+
+        pFTL->read(reqInternal, tick);
+        pDRAM->write(getLineAddress(setIdx, wayIdx), lineSize, tick);
+
+        cacheData[setIdx][wayIdx].validSector.set();
+
+        stat.sectorFill++;
+      }
+
       // Update last accessed time
       cacheData[setIdx][wayIdx].lastAccessed = tick;
 
       // DRAM access
-      pDRAM->read(&cacheData[setIdx][wayIdx], req.length, tick);
+      pDRAM->read(getLineAddress(setIdx, wayIdx), req.length, tick);
 
       debugprint(LOG_ICL_GENERIC_CACHE,
                  "READ  | Cache hit at (%u, %u) | %" PRIu64 " - %" PRIu64
@@ -398,6 +901,23 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
         goto ICL_GENERIC_CACHE_READ;
       }
     }
+    // Do not allocate line, read data from NVM directly
+    else if (admission[0].enabled &&
+             (stream || !checkAdmission(req.range.slpn, partIdx))) {
+      FTL::Request reqInternal(lineCountInSuperPage, req);
+
+      pDRAM->write(getBufferAddress(req.length), req.length, tick);
+
+      pFTL->read(reqInternal, tick);
+
+      debugprint(LOG_ICL_GENERIC_CACHE,
+                 "READ  | Cache bypassed | %" PRIu64 " - %" PRIu64
+                 " (%" PRIu64 ")",
+                 arrived, tick, tick - arrived);
+
+      stat.bypass[0]++;
+      stat.bypassBytes[0] += req.length;
+    }
     // We should read data from NVM
     else {
     ICL_GENERIC_CACHE_READ:
@@ -445,10 +965,10 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
 
         // Find way to write data read from NVM
         setIdx = calcSetIndex(lca);
-        wayIdx = getEmptyWay(setIdx, beginAt);
+        wayIdx = getEmptyWay(setIdx, partIdx, beginAt);
 
         if (wayIdx == waySize) {
-          wayIdx = evictFunction(setIdx, beginAt);
+          wayIdx = evictFunction(setIdx, partIdx, beginAt);
 
           if (cacheData[setIdx][wayIdx].dirty) {
             // We need to evict data before write
@@ -457,10 +977,11 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
           }
         }
 
+        setDirty(cacheData[setIdx] + wayIdx, false);
+
         cacheData[setIdx][wayIdx].insertedAt = beginAt;
         cacheData[setIdx][wayIdx].lastAccessed = beginAt;
         cacheData[setIdx][wayIdx].valid = true;
-        cacheData[setIdx][wayIdx].dirty = false;
 
         readList.push_back({lca, ((uint64_t)setIdx << 32) | wayIdx});
 
@@ -472,7 +993,10 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
       evictCache(tick);
 
       for (auto &iter : readList) {
-        Line *pLine = &cacheData[iter.second >> 32][iter.second & 0xFFFFFFFF];
+        setIdx = iter.second >> 32;
+        wayIdx = iter.second & 0xFFFFFFFF;
+
+        Line *pLine = &cacheData[setIdx][wayIdx];
 
         // Read data
         reqInternal.lpn = iter.first / lineCountInSuperPage;
@@ -486,7 +1010,7 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
 
         // DRAM delay
         dramAt = pLine->insertedAt;
-        pDRAM->write(pLine, lineSize, dramAt);
+        pDRAM->write(getLineAddress(setIdx, wayIdx), lineSize, dramAt);
 
         // Set cache data
         beginAt = MAX(beginAt, dramAt);
@@ -494,6 +1018,7 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
         pLine->insertedAt = beginAt;
         pLine->lastAccessed = beginAt;
         pLine->tag = iter.first;
+        pLine->validSector.set();
 
         if (pLine->tag == req.range.slpn) {
           finishedAt = beginAt;
@@ -502,8 +1027,7 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
         debugprint(LOG_ICL_GENERIC_CACHE,
                    "READ  | Cache miss at (%u, %u) | %" PRIu64 " - %" PRIu64
                    " (%" PRIu64 ")",
-                   iter.second >> 32, iter.second & 0xFFFFFFFF, tick, beginAt,
-                   beginAt - tick);
+                   setIdx, wayIdx, tick, beginAt, beginAt - tick);
       }
 
       tick = finishedAt;
@@ -530,7 +1054,7 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
   else {
     FTL::Request reqInternal(lineCountInSuperPage, req);
 
-    pDRAM->write(nullptr, req.length, tick);
+    pDRAM->write(getBufferAddress(req.length), req.length, tick);
 
     pFTL->read(reqInternal, tick);
   }
@@ -541,6 +1065,14 @@ bool GenericCache::read(Request &req, uint64_t &tick) {
     stat.cache[0]++;
   }
 
+  if (partitionMode != PARTITION_NONE) {
+    partitions[partIdx].request[0]++;
+
+    if (ret) {
+      partitions[partIdx].cache[0]++;
+    }
+  }
+
   return ret;
 }
 
@@ -549,6 +1081,7 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
   bool ret = false;
   uint64_t flash = tick;
   bool dirty = false;
+  uint32_t partIdx = getPartitionIndex(req.nsid);
 
   debugprint(LOG_ICL_GENERIC_CACHE,
              "WRITE | REQ %7u-%-4u | LCA %" PRIu64 " | SIZE %" PRIu64,
@@ -558,6 +1091,9 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
 
   if (req.length < lineSize) {
     dirty = true;
+
+    // Written to NVM directly when bypassed or uncached
+    reqInternal.partialFlag.set(req.range.slpn % lineCountInSuperPage);
   }
   else {
     pFTL->write(reqInternal, flash);
@@ -566,6 +1102,16 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
   if (useWriteCaching) {
     uint32_t setIdx = calcSetIndex(req.range.slpn);
     uint32_t wayIdx;
+    bool stream = false;
+
+    if (partitionMode == PARTITION_UTILITY) {
+      updateMonitor(partIdx, req.range.slpn);
+    }
+
+    if (admission[1].enabled) {
+      sketch.increment(req.range.slpn);
+      stream = checkStream(req, admission[1]);
+    }
 
     wayIdx = getValidWay(req.range.slpn, tick);
 
@@ -591,10 +1137,18 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
       }
 
       // Update last accessed time
-      cacheData[setIdx][wayIdx].dirty = dirty;
+      setDirty(cacheData[setIdx] + wayIdx, dirty);
+
+      // Merge written sectors
+      if (dirty) {
+        setValidSector(cacheData[setIdx] + wayIdx, req.offset, req.length);
+      }
+      else {
+        cacheData[setIdx][wayIdx].validSector.set();
+      }
 
       // DRAM access
-      pDRAM->write(&cacheData[setIdx][wayIdx], req.length, tick);
+      pDRAM->write(getLineAddress(setIdx, wayIdx), req.length, tick);
 
       debugprint(LOG_ICL_GENERIC_CACHE,
                  "WRITE | Cache hit at (%u, %u) | %" PRIu64 " - %" PRIu64
@@ -603,10 +1157,37 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
 
       ret = true;
     }
+    // Do not allocate line, write data to NVM directly
+    else if (admission[1].enabled &&
+             (stream || !checkAdmission(req.range.slpn, partIdx))) {
+      uint64_t arrived = tick;
+
+      if (dirty) {
+        pFTL->write(reqInternal, tick);
+      }
+      else {
+        tick = flash;
+      }
+
+      // TEMP: Disable DRAM calculation for prevent conflict
+      pDRAM->setScheduling(false);
+
+      pDRAM->read(getBufferAddress(req.length), req.length, tick);
+
+      pDRAM->setScheduling(true);
+
+      debugprint(LOG_ICL_GENERIC_CACHE,
+                 "WRITE | Cache bypassed | %" PRIu64 " - %" PRIu64
+                 " (%" PRIu64 ")",
+                 arrived, tick, tick - arrived);
+
+      stat.bypass[1]++;
+      stat.bypassBytes[1] += req.length;
+    }
     else {
       uint64_t arrived = tick;
 
-      wayIdx = getEmptyWay(setIdx, tick);
+      wayIdx = getEmptyWay(setIdx, partIdx, tick);
 
       // Do we have place to write data?
       if (wayIdx != waySize) {
@@ -629,11 +1210,20 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
 
         // Update last accessed time
         cacheData[setIdx][wayIdx].valid = true;
-        cacheData[setIdx][wayIdx].dirty = dirty;
         cacheData[setIdx][wayIdx].tag = req.range.slpn;
 
+        setDirty(cacheData[setIdx] + wayIdx, dirty);
+
+        if (dirty) {
+          cacheData[setIdx][wayIdx].validSector.reset();
+          setValidSector(cacheData[setIdx] + wayIdx, req.offset, req.length);
+        }
+        else {
+          cacheData[setIdx][wayIdx].validSector.set();
+        }
+
         // DRAM access
-        pDRAM->write(&cacheData[setIdx][wayIdx], req.length, tick);
+        pDRAM->write(getLineAddress(setIdx, wayIdx), req.length, tick);
 
         ret = true;
       }
@@ -641,6 +1231,7 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
       else {
         uint32_t row, col;  // Variable for I/O position (IOFlag)
         uint32_t setToFlush = calcSetIndex(req.range.slpn);
+        auto &part = partitions[partIdx];
 
         for (setIdx = 0; setIdx < setSize; setIdx++) {
           for (wayIdx = 0; wayIdx < waySize; wayIdx++) {
@@ -665,14 +1256,18 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
           }
         }
 
-        // We must flush setToFlush set
+        // We must flush setToFlush set (in ways of current partition)
         bool have = false;
 
         for (row = 0; row < lineCountInSuperPage; row++) {
           for (col = 0; col < parallelIO; col++) {
             if (evictData[row][col] &&
                 calcSetIndex(evictData[row][col]->tag) == setToFlush) {
-              have = true;
+              wayIdx = evictData[row][col] - cacheData[setToFlush];
+
+              if (wayIdx >= part.wayBegin && wayIdx < part.wayEnd) {
+                have = true;
+              }
             }
           }
         }
@@ -681,7 +1276,7 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
         if (!have) {
           Line *pLineToFlush = nullptr;
 
-          for (wayIdx = 0; wayIdx < waySize; wayIdx++) {
+          for (wayIdx = part.wayBegin; wayIdx < part.wayEnd; wayIdx++) {
             if (cacheData[setToFlush][wayIdx].valid) {
               pLineToFlush =
                   compareFunction(pLineToFlush, cacheData[setToFlush] + wayIdx);
@@ -695,27 +1290,35 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
           }
         }
 
-        tick += getCacheLatency() * setSize * waySize * 8;
+        readAllMetadata(tick);
 
         evictCache(tick, true);
 
         // Update cacheline of current request
         setIdx = setToFlush;
-        wayIdx = getEmptyWay(setIdx, tick);
+        wayIdx = getEmptyWay(setIdx, partIdx, tick);
 
         if (wayIdx == waySize) {
           panic("Cache corrupted!");
         }
 
         // DRAM latency
-        pDRAM->write(&cacheData[setIdx][wayIdx], req.length, tick);
+        pDRAM->write(getLineAddress(setIdx, wayIdx), req.length, tick);
 
         // Update cache data
         cacheData[setIdx][wayIdx].insertedAt = tick;
         cacheData[setIdx][wayIdx].lastAccessed = tick;
         cacheData[setIdx][wayIdx].valid = true;
-        cacheData[setIdx][wayIdx].dirty = true;
         cacheData[setIdx][wayIdx].tag = req.range.slpn;
+
+        setDirty(cacheData[setIdx] + wayIdx, true);
+
+        if (dirty) {
+          setValidSector(cacheData[setIdx] + wayIdx, req.offset, req.length);
+        }
+        else {
+          cacheData[setIdx][wayIdx].validSector.set();
+        }
       }
 
       debugprint(LOG_ICL_GENERIC_CACHE,
@@ -737,7 +1340,7 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
     // TEMP: Disable DRAM calculation for prevent conflict
     pDRAM->setScheduling(false);
 
-    pDRAM->read(nullptr, req.length, tick);
+    pDRAM->read(getBufferAddress(req.length), req.length, tick);
 
     pDRAM->setScheduling(true);
   }
@@ -748,6 +1351,14 @@ bool GenericCache::write(Request &req, uint64_t &tick) {
     stat.cache[1]++;
   }
 
+  if (partitionMode != PARTITION_NONE) {
+    partitions[partIdx].request[1]++;
+
+    if (ret) {
+      partitions[partIdx].cache[1]++;
+    }
+  }
+
   return ret;
 }
 
@@ -758,25 +1369,42 @@ void GenericCache::flush(LPNRange &range, uint64_t &tick) {
     uint64_t finishedAt = tick;
     FTL::Request reqInternal(lineCountInSuperPage);
 
-    for (uint32_t setIdx = 0; setIdx < setSize; setIdx++) {
-      for (uint32_t wayIdx = 0; wayIdx < waySize; wayIdx++) {
-        Line &line = cacheData[setIdx][wayIdx];
+    // Only visit dirty lines in range
+    auto iter = dirtyLines.lower_bound(range.slpn);
+    auto end = dirtyLines.lower_bound(range.slpn + range.nlp);
 
-        tick += getCacheLatency() * 8;
+    while (iter != end) {
+      // Collect all dirty lines in same super page into one request
+      reqInternal.lpn = iter->first / lineCountInSuperPage;
+      reqInternal.ioFlag.reset();
+      reqInternal.partialFlag.reset();
 
-        if (line.tag >= range.slpn && line.tag < range.slpn + range.nlp) {
-          if (line.dirty) {
-            reqInternal.lpn = line.tag / lineCountInSuperPage;
-            reqInternal.ioFlag.set(line.tag % lineCountInSuperPage);
+      while (iter != end &&
+             iter->first / lineCountInSuperPage == reqInternal.lpn) {
+        uint32_t setIdx = calcSetIndex(iter->first);
+        uint32_t wayIdx = iter->second - cacheData[setIdx];
 
-            ftlTick = tick;
-            pFTL->write(reqInternal, ftlTick);
-            finishedAt = MAX(finishedAt, ftlTick);
-          }
+        readMetadata(setIdx, wayIdx, wayIdx + 1, tick);
+
+        reqInternal.ioFlag.set(iter->first % lineCountInSuperPage);
+        iter->second->dirty = false;
 
-          line.valid = false;
+        // FTL merges old data only when some sectors were never written
+        if (iter->second->validSector.all()) {
+          stat.fullDestage++;
         }
+        else {
+          reqInternal.partialFlag.set(iter->first % lineCountInSuperPage);
+
+          stat.partialDestage++;
+        }
+
+        iter = dirtyLines.erase(iter);
       }
+
+      ftlTick = tick;
+      pFTL->write(reqInternal, ftlTick);
+      finishedAt = MAX(finishedAt, ftlTick);
     }
 
     tick = MAX(tick, finishedAt);
@@ -791,12 +1419,12 @@ void GenericCache::trim(LPNRange &range, uint64_t &tick) {
     uint64_t finishedAt = tick;
     FTL::Request reqInternal(lineCountInSuperPage);
 
+    readAllMetadata(tick);
+
     for (uint32_t setIdx = 0; setIdx < setSize; setIdx++) {
       for (uint32_t wayIdx = 0; wayIdx < waySize; wayIdx++) {
         Line &line = cacheData[setIdx][wayIdx];
 
-        tick += getCacheLatency() * 8;
-
         if (line.tag >= range.slpn && line.tag < range.slpn + range.nlp) {
           reqInternal.lpn = line.tag / lineCountInSuperPage;
           reqInternal.ioFlag.set(line.tag % lineCountInSuperPage);
@@ -805,7 +1433,7 @@ void GenericCache::trim(LPNRange &range, uint64_t &tick) {
           pFTL->trim(reqInternal, ftlTick);
           finishedAt = MAX(finishedAt, ftlTick);
 
-          line.valid = false;
+          invalidate(&line);
         }
       }
     }
@@ -828,7 +1456,7 @@ void GenericCache::format(LPNRange &range, uint64_t &tick) {
 
       if (wayIdx != waySize) {
         // Invalidate
-        cacheData[setIdx][wayIdx].valid = false;
+        invalidate(cacheData[setIdx] + wayIdx);
       }
     }
   }
@@ -859,6 +1487,74 @@ void GenericCache::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.name = prefix + "generic_cache.write.to_cache";
   temp.desc = "Write requests that served to cache";
   list.push_back(temp);
+
+  if (tagCacheSets > 0) {
+    temp.name = prefix + "generic_cache.tag_cache.hit";
+    temp.desc = "Metadata lookups served from tag cache";
+    list.push_back(temp);
+
+    temp.name = prefix + "generic_cache.tag_cache.miss";
+    temp.desc = "Metadata lookups served from DRAM";
+    list.push_back(temp);
+  }
+
+  if (admission[0].enabled || admission[1].enabled) {
+    temp.name = prefix + "generic_cache.read.bypass_count";
+    temp.desc = "Read requests that bypassed cache by admission filter";
+    list.push_back(temp);
+
+    temp.name = prefix + "generic_cache.read.bypass_bytes";
+    temp.desc = "Bytes of read requests that bypassed cache";
+    list.push_back(temp);
+
+    temp.name = prefix + "generic_cache.write.bypass_count";
+    temp.desc = "Write requests that bypassed cache by admission filter";
+    list.push_back(temp);
+
+    temp.name = prefix + "generic_cache.write.bypass_bytes";
+    temp.desc = "Bytes of write requests that bypassed cache";
+    list.push_back(temp);
+  }
+
+  temp.name = prefix + "generic_cache.sector.fill";
+  temp.desc = "Partially written lines filled from NVM on read";
+  list.push_back(temp);
+
+  temp.name = prefix + "generic_cache.destage.full";
+  temp.desc = "Dirty lines written back without reading old data";
+  list.push_back(temp);
+
+  temp.name = prefix + "generic_cache.destage.partial";
+  temp.desc = "Dirty lines merged with old data before write back";
+  list.push_back(temp);
+
+  if (partitionMode != PARTITION_NONE) {
+    std::string number;
+
+    for (uint32_t i = 0; i < partitions.size(); i++) {
+      number = std::to_string(i + 1);
+
+      temp.name = prefix + "generic_cache.ns" + number + ".read.request_count";
+      temp.desc = "Read request count of namespace " + number;
+      list.push_back(temp);
+
+      temp.name = prefix + "generic_cache.ns" + number + ".read.from_cache";
+      temp.desc = "Read requests of namespace " + number + " served from cache";
+      list.push_back(temp);
+
+      temp.name = prefix + "generic_cache.ns" + number + ".write.request_count";
+      temp.desc = "Write request count of namespace " + number;
+      list.push_back(temp);
+
+      temp.name = prefix + "generic_cache.ns" + number + ".write.to_cache";
+      temp.desc = "Write requests of namespace " + number + " served to cache";
+      list.push_back(temp);
+
+      temp.name = prefix + "generic_cache.ns" + number + ".ways";
+      temp.desc = "Cache ways allocated to namespace " + number;
+      list.push_back(temp);
+    }
+  }
 }
 
 void GenericCache::getStatValues(std::vector<double> &values) {
@@ -866,10 +1562,41 @@ void GenericCache::getStatValues(std::vector<double> &values) {
   values.push_back(stat.cache[0]);
   values.push_back(stat.request[1]);
   values.push_back(stat.cache[1]);
+
+  if (tagCacheSets > 0) {
+    values.push_back(stat.tagCache[0]);
+    values.push_back(stat.tagCache[1]);
+  }
+
+  if (admission[0].enabled || admission[1].enabled) {
+    values.push_back(stat.bypass[0]);
+    values.push_back(stat.bypassBytes[0]);
+    values.push_back(stat.bypass[1]);
+    values.push_back(stat.bypassBytes[1]);
+  }
+
+  values.push_back(stat.sectorFill);
+  values.push_back(stat.fullDestage);
+  values.push_back(stat.partialDestage);
+
+  if (partitionMode != PARTITION_NONE) {
+    for (auto &iter : partitions) {
+      values.push_back(iter.request[0]);
+      values.push_back(iter.cache[0]);
+      values.push_back(iter.request[1]);
+      values.push_back(iter.cache[1]);
+      values.push_back(iter.wayEnd - iter.wayBegin);
+    }
+  }
 }
 
 void GenericCache::resetStatValues() {
   memset(&stat, 0, sizeof(stat));
+
+  for (auto &iter : partitions) {
+    memset(iter.request, 0, sizeof(iter.request));
+    memset(iter.cache, 0, sizeof(iter.cache));
+  }
 }
 
 }  // namespace ICL
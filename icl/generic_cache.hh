@@ -21,7 +21,10 @@
 #define __ICL_GENERIC_CACHE__
 
 #include <functional>
+#include <list>
+#include <map>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "icl/abstract_cache.hh"
@@ -37,6 +40,7 @@ class GenericCache : public AbstractCache {
   uint32_t lineCountInSuperPage;
   uint32_t lineCountInMaxIO;
   uint32_t lineSize;
+  uint32_t sectorCount;
   uint32_t setSize;
   uint32_t waySize;
 
@@ -66,7 +70,7 @@ class GenericCache : public AbstractCache {
   PREFETCH_MODE prefetchMode;
   EVICT_MODE evictMode;
   EVICT_POLICY policy;
-  std::function<uint32_t(uint32_t, uint64_t &)> evictFunction;
+  std::function<uint32_t(uint32_t, uint32_t, uint64_t &)> evictFunction;
   std::function<Line *(Line *, Line *)> compareFunction;
   std::random_device rd;
   std::mt19937 gen;
@@ -75,14 +79,94 @@ class GenericCache : public AbstractCache {
   std::vector<Line *> cacheData;
   std::vector<Line **> evictData;
 
+  // Dirty lines ordered by tag (LCA)
+  std::map<uint64_t, Line *> dirtyLines;
+
+  // Namespace partitioning
+  struct Partition {
+    uint32_t wayBegin;
+    uint32_t wayEnd;
+
+    // Utility monitor (hits per LRU stack position of sampled sets)
+    std::vector<uint64_t> hitCounter;
+    std::vector<std::vector<uint64_t>> shadowTags;
+
+    uint64_t request[2];
+    uint64_t cache[2];
+
+    Partition();
+  };
+
+  PARTITION_MODE partitionMode;
+  uint64_t partitionInterval;
+  uint64_t partitionAccessCount;
+  uint32_t monitorStride;
+  std::vector<Partition> partitions;
+
+  // Metadata access
+  bool useMetadataDRAM;
+  uint32_t tagCacheSets;
+  uint64_t tagCacheLatency;  //!< SRAM lookup of one set
+  std::list<uint32_t> tagCacheLRU;
+  std::unordered_map<uint32_t, std::list<uint32_t>::iterator> tagCacheMap;
+
+  // Cache admission
+  struct Admission {
+    bool enabled;
+    uint64_t nextAddress;
+    uint64_t streamSize;  // Bytes of current sequential stream
+
+    Admission();
+  } admission[2];
+
+  uint64_t bypassSize;
+
+  // DRAM regions
+  uint32_t dataRegion;
+  uint32_t metadataRegion;
+  uint32_t bufferRegion;  // Data not cached (bypass and uncached I/O)
+  uint64_t bufferSize;
+  uint64_t bufferOffset;
+
+  // TinyLFU-style count-min sketch of line access frequency
+  struct FrequencySketch {
+    uint32_t mask;
+    uint64_t additions;
+    uint64_t sampleSize;
+    std::vector<uint8_t> table;
+
+    FrequencySketch();
+
+    void init(uint64_t);
+    uint32_t index(uint64_t, uint32_t);
+    void increment(uint64_t);
+    uint8_t estimate(uint64_t);
+  } sketch;
+
   uint64_t getCacheLatency();
+  void *getLineAddress(uint32_t, uint32_t);
+  void *getBufferAddress(uint64_t);
+  void readMetadata(uint32_t, uint32_t, uint32_t, uint64_t &);
+  void readAllMetadata(uint64_t &);
 
   uint32_t calcSetIndex(uint64_t);
   void calcIOPosition(uint64_t, uint32_t &, uint32_t &);
 
-  uint32_t getEmptyWay(uint32_t, uint64_t &);
+  uint32_t getPartitionIndex(uint32_t);
+  void setPartitionWays(std::vector<uint32_t> &);
+  void updateMonitor(uint32_t, uint64_t);
+  void updatePartition();
+
+  uint32_t getEmptyWay(uint32_t, uint32_t, uint64_t &);
   uint32_t getValidWay(uint64_t, uint64_t &);
   void checkSequential(Request &, SequentialDetect &);
+  bool checkStream(Request &, Admission &);
+  bool checkAdmission(uint64_t, uint32_t);
+
+  void setDirty(Line *, bool);
+  void invalidate(Line *);
+  void setValidSector(Line *, uint64_t, uint64_t);
+  bool checkValidSector(Line *, uint64_t, uint64_t);
 
   void evictCache(uint64_t, bool = true);
 
@@ -90,6 +174,12 @@ class GenericCache : public AbstractCache {
   struct {
     uint64_t request[2];
     uint64_t cache[2];
+    uint64_t tagCache[2];
+    uint64_t sectorFill;  // Line fills from NAND for missing sectors
+    uint64_t fullDestage;
+    uint64_t partialDestage;
+    uint64_t bypass[2];
+    uint64_t bypassBytes[2];
   } stat;
 
  public:
@@ -20,6 +20,7 @@
 #include "icl/icl.hh"
 
 #include "dram/simple.hh"
+#include "dram/timing.hh"
 #include "icl/generic_cache.hh"
 #include "util/algorithm.hh"
 #include "util/def.hh"
@@ -33,6 +34,10 @@ ICL::ICL(ConfigReader &c) : conf(c) {
     case DRAM::SIMPLE_MODEL:
       pDRAM = new DRAM::SimpleDRAM(conf);
 
+      break;
+    case DRAM::TIMING_MODEL:
+      pDRAM = new DRAM::TimingDRAM(conf);
+
       break;
     default:
       panic("Undefined DRAM model");
@@ -71,6 +76,7 @@ void ICL::read(Request &req, uint64_t &tick) {
 
   reqInternal.reqID = req.reqID;
   reqInternal.offset = req.offset;
+  reqInternal.nsid = req.nsid;
 
   for (uint64_t i = 0; i < req.range.nlp; i++) {
     beginAt = tick;
@@ -103,6 +109,7 @@ void ICL::write(Request &req, uint64_t &tick) {
 
   reqInternal.reqID = req.reqID;
   reqInternal.offset = req.offset;
+  reqInternal.nsid = req.nsid;
 
   for (uint64_t i = 0; i < req.range.nlp; i++) {
     beginAt = tick;
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pal/abstract_pal.hh"
+
+#include "pal/old/Latency.h"
+#include "pal/old/LatencyMLC.h"
+#include "pal/old/LatencySLC.h"
+#include "pal/old/LatencyTLC.h"
+#include "pal/old/LatencyTable.h"
+#include "util/algorithm.hh"
+
+namespace SimpleSSD {
+
+namespace PAL {
+
+AbstractPAL::AbstractPAL(Parameter &p, ConfigReader &c) : param(p), conf(c) {
+  pageAllocation = conf.getPageAllocationConfig();
+  superblock = conf.getSuperblockConfig();
+  useMultiplaneOP = conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP);
+  bRandomTweak = conf.readBoolean(CONFIG_FTL, FTL::FTL_USE_RANDOM_IO_TWEAK);
+
+  // One request generates at most pageInSuperPage addresses
+  addressList.reserve(param.pageInSuperPage);
+}
+
+void AbstractPAL::convertCPDPBP(Request &req, std::vector<::CPDPBP> &list) {
+  ::CPDPBP addr;
+  uint32_t pageInSuperPage = param.pageInSuperPage;
+  uint32_t value[4];
+  uint32_t *ptr[4];
+  uint64_t tmp = req.blockIndex;
+  int count = 0;
+
+  if (bRandomTweak && req.ioFlag.size() != pageInSuperPage) {
+    panic("Invalid size of I/O flag");
+  }
+
+  if (!bRandomTweak && req.ioFlag.size() != pageInSuperPage) {
+    req.ioFlag = Bitset(pageInSuperPage);
+    req.ioFlag.set();
+  }
+
+  list.clear();
+
+  addr.Plane = 0;
+
+  for (int i = 0; i < 4; i++) {
+    uint8_t idx = (pageAllocation >> (i * 8)) & 0xFF;
+
+    switch (idx) {
+      case INDEX_CHANNEL:
+        if (superblock & INDEX_CHANNEL) {
+          value[count] = param.channel;
+          ptr[count++] = &addr.Channel;
+        }
+        else {
+          addr.Channel = tmp % param.channel;
+          tmp /= param.channel;
+        }
+
+        break;
+      case INDEX_PACKAGE:
+        if (superblock & INDEX_PACKAGE) {
+          value[count] = param.package;
+          ptr[count++] = &addr.Package;
+        }
+        else {
+          addr.Package = tmp % param.package;
+          tmp /= param.package;
+        }
+
+        break;
+      case INDEX_DIE:
+        if (superblock & INDEX_DIE) {
+          value[count] = param.die;
+          ptr[count++] = &addr.Die;
+        }
+        else {
+          addr.Die = tmp % param.die;
+          tmp /= param.die;
+        }
+
+        break;
+      case INDEX_PLANE:
+        if (!useMultiplaneOP) {
+          if (superblock & INDEX_PLANE) {
+            value[count] = param.plane;
+            ptr[count++] = &addr.Plane;
+          }
+          else {
+            addr.Plane = tmp % param.plane;
+            tmp /= param.plane;
+          }
+        }
+
+        break;
+      default:
+        break;
+    }
+  }
+
+  addr.Block = tmp;
+  addr.Page = req.pageIndex;
+
+  // Index of ioFlag
+  tmp = 0;
+
+  if (count == 4) {
+    list.reserve(value[0] * value[1] * value[2] * value[3]);
+
+    for (uint32_t i = 0; i < value[3]; i++) {
+      for (uint32_t j = 0; j < value[2]; j++) {
+        for (uint32_t k = 0; k < value[1]; k++) {
+          for (uint32_t l = 0; l < value[0]; l++) {
+            if (req.ioFlag.test(tmp++)) {
+              *ptr[0] = l;
+              *ptr[1] = k;
+              *ptr[2] = j;
+              *ptr[3] = i;
+
+              list.push_back(addr);
+            }
+          }
+        }
+      }
+    }
+  }
+  else if (count == 3) {
+    list.reserve(value[0] * value[1] * value[2]);
+
+    for (uint32_t j = 0; j < value[2]; j++) {
+      for (uint32_t k = 0; k < value[1]; k++) {
+        for (uint32_t l = 0; l < value[0]; l++) {
+          if (req.ioFlag.test(tmp++)) {
+            *ptr[0] = l;
+            *ptr[1] = k;
+            *ptr[2] = j;
+
+            list.push_back(addr);
+          }
+        }
+      }
+    }
+  }
+  else if (count == 2) {
+    list.reserve(value[0] * value[1]);
+
+    for (uint32_t k = 0; k < value[1]; k++) {
+      for (uint32_t l = 0; l < value[0]; l++) {
+        if (req.ioFlag.test(tmp++)) {
+          *ptr[0] = l;
+          *ptr[1] = k;
+
+          list.push_back(addr);
+        }
+      }
+    }
+  }
+  else if (count == 1) {
+    list.reserve(value[0]);
+
+    for (uint32_t l = 0; l < value[0]; l++) {
+      if (req.ioFlag.test(tmp++)) {
+        *ptr[0] = l;
+
+        list.push_back(addr);
+      }
+    }
+  }
+  else {
+    if (req.ioFlag.test(tmp++)) {
+      list.push_back(addr);
+    }
+  }
+
+  if (tmp != pageInSuperPage) {
+    panic("I/O flag size != # pages in super page");
+  }
+}
+
+void AbstractPAL::read(std::vector<Request> &list, uint64_t &tick) {
+  uint64_t finishedAt = tick;
+  uint64_t beginAt;
+
+  for (auto &iter : list) {
+    beginAt = tick;
+
+    read(iter, beginAt);
+
+    finishedAt = MAX(finishedAt, beginAt);
+  }
+
+  tick = finishedAt;
+}
+
+void AbstractPAL::write(std::vector<Request> &list, uint64_t &tick) {
+  uint64_t finishedAt = tick;
+  uint64_t beginAt;
+
+  for (auto &iter : list) {
+    beginAt = tick;
+
+    write(iter, beginAt);
+
+    finishedAt = MAX(finishedAt, beginAt);
+  }
+
+  tick = finishedAt;
+}
+
+void AbstractPAL::erase(std::vector<Request> &list, uint64_t &tick) {
+  uint64_t finishedAt = tick;
+  uint64_t beginAt;
+
+  for (auto &iter : list) {
+    beginAt = tick;
+
+    erase(iter, beginAt);
+
+    finishedAt = MAX(finishedAt, beginAt);
+  }
+
+  tick = finishedAt;
+}
+
+::Latency *AbstractPAL::createLatency() {
+  Config::NANDTiming *pTiming = conf.getNANDTiming();
+  Config::NANDPower *pPower = conf.getNANDPower();
+  std::vector<Config::NANDZone> *pZone = conf.getNANDZone();
+  PROGRAM_SCHEME scheme =
+      (PROGRAM_SCHEME)conf.readInt(CONFIG_PAL, NAND_PROGRAM_SCHEME);
+  NAND_TYPE type = (NAND_TYPE)conf.readInt(CONFIG_PAL, NAND_FLASH_TYPE);
+  uint32_t bits = 0;
+
+  switch (type) {
+    case NAND_SLC:
+      bits = 1;
+
+      break;
+    case NAND_MLC:
+      bits = 2;
+
+      break;
+    case NAND_TLC:
+      bits = 3;
+
+      break;
+    case NAND_QLC:
+      bits = 4;
+
+      break;
+    default:
+      panic("Undefined NAND type");
+  }
+
+  // Use legacy latency models when table is not required
+  if (type != NAND_QLC && pZone->size() == 0 && scheme == PROGRAM_ONE_SHOT) {
+    switch (type) {
+      case NAND_SLC:
+        return new LatencySLC(*pTiming, *pPower);
+      case NAND_MLC:
+        return new LatencyMLC(*pTiming, *pPower);
+      default:
+        return new LatencyTLC(*pTiming, *pPower);
+    }
+  }
+
+  return new LatencyTable(*pTiming, *pPower, param.page, bits, scheme, *pZone);
+}
+
+void AbstractPAL::submit(Request &, PAL_OPERATION, DMAFunction &, void *) {
+  panic("Asynchronous interface is not supported by this PAL model");
+}
+
+}  // namespace PAL
+
+}  // namespace SimpleSSD
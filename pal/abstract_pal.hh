@@ -21,8 +21,13 @@
 #define __PAL_ABSTRACT_PAL__
 
 #include <cinttypes>
+#include <vector>
 
 #include "pal/pal.hh"
+#include "sim/dma_interface.hh"
+#include "util/old/SimpleSSD_types.h"
+
+class Latency;
 
 namespace SimpleSSD {
 
@@ -33,13 +38,34 @@ class AbstractPAL : public StatObject {
   Parameter &param;
   ConfigReader &conf;
 
+  // Reused by every request, so converting request does not allocate memory
+  std::vector<::CPDPBP> addressList;
+
+  void convertCPDPBP(Request &, std::vector<::CPDPBP> &);
+  ::Latency *createLatency();
+
+ private:
+  uint32_t pageAllocation;
+  uint8_t superblock;
+  bool useMultiplaneOP;
+  bool bRandomTweak;
+
  public:
-  AbstractPAL(Parameter &p, ConfigReader &c) : param(p), conf(c) {}
+  AbstractPAL(Parameter &, ConfigReader &);
   virtual ~AbstractPAL() {}
 
   virtual void read(Request &, uint64_t &) = 0;
   virtual void write(Request &, uint64_t &) = 0;
   virtual void erase(Request &, uint64_t &) = 0;
+
+  // All requests arrive at tick, tick becomes last finish tick
+  virtual void read(std::vector<Request> &, uint64_t &);
+  virtual void write(std::vector<Request> &, uint64_t &);
+  virtual void erase(std::vector<Request> &, uint64_t &);
+
+  // Asynchronous interface, func is called when all pages are finished
+  virtual void submit(Request &, PAL_OPERATION, DMAFunction &,
+                      void * = nullptr);
 };
 
 }  // namespace PAL
@@ -29,6 +29,28 @@ const char NAME_CHANNEL[] = "Channel";
 const char NAME_PACKAGE[] = "Package";
 const char NAME_PAGE_ALLOCATION[] = "PageAllocation";
 const char NAME_SUPER_BLOCK[] = "SuperblockSize";
+const char NAME_MODEL[] = "Model";
+const char NAME_SCHEDULER[] = "Scheduler";
+const char NAME_STARVATION_LIMIT[] = "StarvationLimit";
+const char NAME_USE_SUSPEND[] = "EnableSuspend";
+const char NAME_SUSPEND_LATENCY[] = "SuspendLatency";
+const char NAME_MAX_SUSPEND[] = "MaxSuspendCount";
+const char NAME_USE_PLANE_MERGE[] = "EnablePlaneMerge";
+const char NAME_USE_CACHE_READ[] = "EnableCacheRead";
+const char NAME_USE_CACHE_PROGRAM[] = "EnableCacheProgram";
+const char NAME_USE_READ_RETRY[] = "EnableReadRetry";
+const char NAME_INITIAL_PE_CYCLE[] = "InitialPECycle";
+const char NAME_INITIAL_RETENTION[] = "InitialRetention";
+const char NAME_RBER_BASE[] = "RBERBase";
+const char NAME_RBER_WEAR[] = "RBERWear";
+const char NAME_RBER_RETENTION[] = "RBERRetention";
+const char NAME_RBER_DISTURB[] = "RBERDisturb";
+const char NAME_CORRECTABLE_RBER[] = "CorrectableRBER";
+const char NAME_RETRY_GAIN[] = "RetryGain";
+const char NAME_MAX_READ_RETRY[] = "MaxReadRetry";
+const char NAME_DECODE_LATENCY[] = "DecodeLatency";
+const char NAME_SOFT_DECODE_LATENCY[] = "SoftDecodeLatency";
+const char NAME_STAT_LEVEL[] = "StatLevel";
 
 /* NAND config TODO: seperate this */
 const char NAME_DIE[] = "Die";
@@ -40,6 +62,10 @@ const char NAME_USE_MULTI_PLANE_OP[] = "EnableMultiPlaneOperation";
 const char NAME_DMA_SPEED[] = "DMASpeed";
 const char NAME_DMA_WIDTH[] = "DMAWidth";
 const char NAME_FLASH_TYPE[] = "NANDType";
+const char NAME_PROGRAM_SCHEME[] = "ProgramScheme";
+const char NAME_WORDLINE_ZONE[] = "WordlineZone";
+const char NAME_ZONE_READ_SCALE[] = "ZoneReadScale";
+const char NAME_ZONE_WRITE_SCALE[] = "ZoneWriteScale";
 
 /* NAND timing TODO: seperate this */
 const char NAME_NAND_LSB_READ[] = "LSBRead";
@@ -48,6 +74,8 @@ const char NAME_NAND_CSB_READ[] = "CSBRead";
 const char NAME_NAND_CSB_WRITE[] = "CSBWrite";
 const char NAME_NAND_MSB_READ[] = "MSBRead";
 const char NAME_NAND_MSB_WRITE[] = "MSBWrite";
+const char NAME_NAND_TSB_READ[] = "TSBRead";
+const char NAME_NAND_TSB_WRITE[] = "TSBWrite";
 const char NAME_NAND_ERASE[] = "Erase";
 
 /* NAND power TODO: seperate this */
@@ -66,9 +94,51 @@ const uint8_t readCycle = 7;
 const uint8_t writeCycle = 7;
 const uint8_t eraseCycle = 5;
 
+// Parse comma separated list of numbers
+static void parseList(std::string &str, std::vector<uint32_t> &list) {
+  const char *ptr = str.c_str();
+  char *end;
+
+  list.clear();
+
+  while (*ptr) {
+    uint32_t value = strtoul(ptr, &end, 10);
+
+    if (ptr == end) {
+      ptr++;
+    }
+    else {
+      list.push_back(value);
+      ptr = end;
+    }
+  }
+}
+
 Config::Config() {
   channel = 8;
   package = 4;
+  model = OLD_MODEL;
+  scheduler = SCHEDULER_FIFO;
+  starvationLimit = 5000000000;
+  useSuspend = false;
+  suspendLatency = 20000000;
+  maxSuspend = 4;
+  usePlaneMerge = false;
+  useCacheRead = false;
+  useCacheProgram = false;
+  useReadRetry = false;
+  initialPECycle = 0;
+  initialRetention = 0;
+  rberBase = 0.000001f;
+  rberWear = 0.0001f;
+  rberRetention = 0.000001f;
+  rberDisturb = 0.00001f;
+  correctableRBER = 0.001f;
+  retryGain = 0.5f;
+  maxReadRetry = 8;
+  decodeLatency = 2000000;
+  softDecodeLatency = 20000000;
+  statLevel = STAT_COUNTER;
   die = 2;
   plane = 1;
   block = 512;
@@ -78,6 +148,7 @@ Config::Config() {
   dmaSpeed = 400;
   dmaWidth = 8;
   nandType = NAND_MLC;
+  programScheme = PROGRAM_ONE_SHOT;
 
   // Set NAND timing (Default: MLC, csb is not used)
   nandTiming.lsb.read = 40000000;    // 40us
@@ -86,6 +157,8 @@ Config::Config() {
   nandTiming.csb.write = 0;
   nandTiming.msb.read = 65000000;     // 65us
   nandTiming.msb.write = 1300000000;  // 1300us
+  nandTiming.tsb.read = 0;
+  nandTiming.tsb.write = 0;
   nandTiming.erase = 3500000000;      // 3.5ms
 
   // Set NAND power (From: Micron's MT29F64*)
@@ -109,6 +182,72 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_PACKAGE)) {
     package = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_MODEL)) {
+    model = (MODEL)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_SCHEDULER)) {
+    scheduler = (SCHEDULER)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_STARVATION_LIMIT)) {
+    starvationLimit = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_USE_SUSPEND)) {
+    useSuspend = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_SUSPEND_LATENCY)) {
+    suspendLatency = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_MAX_SUSPEND)) {
+    maxSuspend = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_USE_PLANE_MERGE)) {
+    usePlaneMerge = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_USE_CACHE_READ)) {
+    useCacheRead = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_USE_CACHE_PROGRAM)) {
+    useCacheProgram = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_USE_READ_RETRY)) {
+    useReadRetry = convertBool(value);
+  }
+  else if (MATCH_NAME(NAME_INITIAL_PE_CYCLE)) {
+    initialPECycle = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_INITIAL_RETENTION)) {
+    initialRetention = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_RBER_BASE)) {
+    rberBase = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_RBER_WEAR)) {
+    rberWear = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_RBER_RETENTION)) {
+    rberRetention = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_RBER_DISTURB)) {
+    rberDisturb = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_CORRECTABLE_RBER)) {
+    correctableRBER = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_RETRY_GAIN)) {
+    retryGain = strtof(value, nullptr);
+  }
+  else if (MATCH_NAME(NAME_MAX_READ_RETRY)) {
+    maxReadRetry = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_DECODE_LATENCY)) {
+    decodeLatency = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_SOFT_DECODE_LATENCY)) {
+    softDecodeLatency = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_STAT_LEVEL)) {
+    statLevel = (STAT_LEVEL)strtoul(value, nullptr, 10);
+  }
   else if (MATCH_NAME(NAME_DIE)) {
     die = strtoul(value, nullptr, 10);
   }
@@ -136,6 +275,18 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_FLASH_TYPE)) {
     nandType = (NAND_TYPE)strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_PROGRAM_SCHEME)) {
+    programScheme = (PROGRAM_SCHEME)strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_WORDLINE_ZONE)) {
+    _wordlineZone = value;
+  }
+  else if (MATCH_NAME(NAME_ZONE_READ_SCALE)) {
+    _zoneReadScale = value;
+  }
+  else if (MATCH_NAME(NAME_ZONE_WRITE_SCALE)) {
+    _zoneWriteScale = value;
+  }
   else if (MATCH_NAME(NAME_SUPER_BLOCK)) {
     _superblock = value;
   }
@@ -160,6 +311,12 @@ bool Config::setConfig(const char *name, const char *value) {
   else if (MATCH_NAME(NAME_NAND_MSB_WRITE)) {
     nandTiming.msb.write = strtoul(value, nullptr, 10);
   }
+  else if (MATCH_NAME(NAME_NAND_TSB_READ)) {
+    nandTiming.tsb.read = strtoul(value, nullptr, 10);
+  }
+  else if (MATCH_NAME(NAME_NAND_TSB_WRITE)) {
+    nandTiming.tsb.write = strtoul(value, nullptr, 10);
+  }
   else if (MATCH_NAME(NAME_NAND_ERASE)) {
     nandTiming.erase = strtoul(value, nullptr, 10);
   }
@@ -193,6 +350,15 @@ void Config::update() {
     panic("dmaWidth should be multiple of 8.");
   }
 
+  if (useReadRetry) {
+    if (retryGain <= 0.f || retryGain >= 1.f) {
+      panic("RetryGain should be in range (0, 1)");
+    }
+    if (correctableRBER <= 0.f) {
+      panic("CorrectableRBER should be larger than 0");
+    }
+  }
+
   // DMA time calculation
   //                 MT/s       MT -> T    ms     us     ns     ps
   float tCK = 1.f / (dmaSpeed * 1048576) * 1000 * 1000 * 1000 * 1000;
@@ -294,15 +460,53 @@ void Config::update() {
   if (useMultiPlaneOperation) {
     superblock |= INDEX_PLANE;
   }
+
+  // Parse wordline zone setting
+  std::vector<uint32_t> wordline;
+  std::vector<uint32_t> readScale;
+  std::vector<uint32_t> writeScale;
+
+  parseList(_wordlineZone, wordline);
+  parseList(_zoneReadScale, readScale);
+  parseList(_zoneWriteScale, writeScale);
+
+  if (wordline.size() != readScale.size() ||
+      wordline.size() != writeScale.size()) {
+    panic("# values of WordlineZone, ZoneReadScale and ZoneWriteScale differ");
+  }
+
+  nandZone.resize(wordline.size());
+
+  for (i = 0; i < (int)wordline.size(); i++) {
+    if (i > 0 && wordline[i] <= wordline[i - 1]) {
+      panic("WordlineZone should be in ascending order");
+    }
+
+    nandZone[i].wordline = wordline[i];
+    nandZone[i].readScale = readScale[i];
+    nandZone[i].writeScale = writeScale[i];
+  }
 }
 
 int64_t Config::readInt(uint32_t idx) {
   int64_t ret = 0;
 
   switch (idx) {
+    case PAL_MODEL:
+      ret = model;
+      break;
+    case PAL_SCHEDULER:
+      ret = scheduler;
+      break;
     case NAND_FLASH_TYPE:
       ret = nandType;
       break;
+    case NAND_PROGRAM_SCHEME:
+      ret = programScheme;
+      break;
+    case PAL_STAT_LEVEL:
+      ret = statLevel;
+      break;
   }
 
   return ret;
@@ -318,6 +522,30 @@ uint64_t Config::readUint(uint32_t idx) {
     case PAL_PACKAGE:
       ret = package;
       break;
+    case PAL_STARVATION_LIMIT:
+      ret = starvationLimit;
+      break;
+    case PAL_SUSPEND_LATENCY:
+      ret = suspendLatency;
+      break;
+    case PAL_MAX_SUSPEND:
+      ret = maxSuspend;
+      break;
+    case PAL_INITIAL_PE_CYCLE:
+      ret = initialPECycle;
+      break;
+    case PAL_INITIAL_RETENTION:
+      ret = initialRetention;
+      break;
+    case PAL_MAX_READ_RETRY:
+      ret = maxReadRetry;
+      break;
+    case PAL_DECODE_LATENCY:
+      ret = decodeLatency;
+      break;
+    case PAL_SOFT_DECODE_LATENCY:
+      ret = softDecodeLatency;
+      break;
     case NAND_DIE:
       ret = die;
       break;
@@ -344,10 +572,52 @@ uint64_t Config::readUint(uint32_t idx) {
   return ret;
 }
 
+float Config::readFloat(uint32_t idx) {
+  float ret = 0.f;
+
+  switch (idx) {
+    case PAL_RBER_BASE:
+      ret = rberBase;
+      break;
+    case PAL_RBER_WEAR:
+      ret = rberWear;
+      break;
+    case PAL_RBER_RETENTION:
+      ret = rberRetention;
+      break;
+    case PAL_RBER_DISTURB:
+      ret = rberDisturb;
+      break;
+    case PAL_CORRECTABLE_RBER:
+      ret = correctableRBER;
+      break;
+    case PAL_RETRY_GAIN:
+      ret = retryGain;
+      break;
+  }
+
+  return ret;
+}
+
 bool Config::readBoolean(uint32_t idx) {
   bool ret = false;
 
   switch (idx) {
+    case PAL_USE_SUSPEND:
+      ret = useSuspend;
+      break;
+    case PAL_USE_PLANE_MERGE:
+      ret = usePlaneMerge;
+      break;
+    case PAL_USE_CACHE_READ:
+      ret = useCacheRead;
+      break;
+    case PAL_USE_CACHE_PROGRAM:
+      ret = useCacheProgram;
+      break;
+    case PAL_USE_READ_RETRY:
+      ret = useReadRetry;
+      break;
     case NAND_USE_MULTI_PLANE_OP:
       ret = useMultiPlaneOperation;
       break;
@@ -374,6 +644,10 @@ Config::NANDPower *Config::getNANDPower() {
   return &nandPower;
 }
 
+std::vector<Config::NANDZone> *Config::getNANDZone() {
+  return &nandZone;
+}
+
 }  // namespace PAL
 
 }  // namespace SimpleSSD
@@ -20,6 +20,8 @@
 #ifndef __PAL_CONFIG__
 #define __PAL_CONFIG__
 
+#include <vector>
+
 #include "sim/base_config.hh"
 
 namespace SimpleSSD {
@@ -30,6 +32,28 @@ typedef enum {
   /* PAL config */
   PAL_CHANNEL,
   PAL_PACKAGE,
+  PAL_MODEL,
+  PAL_SCHEDULER,
+  PAL_STARVATION_LIMIT,
+  PAL_USE_SUSPEND,
+  PAL_SUSPEND_LATENCY,
+  PAL_MAX_SUSPEND,
+  PAL_USE_PLANE_MERGE,
+  PAL_USE_CACHE_READ,
+  PAL_USE_CACHE_PROGRAM,
+  PAL_USE_READ_RETRY,
+  PAL_INITIAL_PE_CYCLE,
+  PAL_INITIAL_RETENTION,
+  PAL_RBER_BASE,
+  PAL_RBER_WEAR,
+  PAL_RBER_RETENTION,
+  PAL_RBER_DISTURB,
+  PAL_CORRECTABLE_RBER,
+  PAL_RETRY_GAIN,
+  PAL_MAX_READ_RETRY,
+  PAL_DECODE_LATENCY,
+  PAL_SOFT_DECODE_LATENCY,
+  PAL_STAT_LEVEL,
 
   /* NAND config TODO: seperate this */
   NAND_DIE,
@@ -41,14 +65,38 @@ typedef enum {
   NAND_DMA_SPEED,
   NAND_DMA_WIDTH,
   NAND_FLASH_TYPE,
+  NAND_PROGRAM_SCHEME,
 } PAL_CONFIG;
 
+typedef enum {
+  OLD_MODEL,
+  EVENT_MODEL,
+} MODEL;
+
+typedef enum {
+  SCHEDULER_FIFO,
+  SCHEDULER_READ_FIRST,
+  SCHEDULER_OLDEST_FIRST,
+} SCHEDULER;
+
+typedef enum {
+  STAT_COUNTER,      //!< Count, energy and average latency
+  STAT_LATENCY,      //!< Latency breakdown and histogram
+  STAT_UTILIZATION,  //!< Active time of each channel and die
+} STAT_LEVEL;
+
 typedef enum {
   NAND_SLC,
   NAND_MLC,
   NAND_TLC,
+  NAND_QLC,
 } NAND_TYPE;
 
+typedef enum {
+  PROGRAM_ONE_SHOT,  //!< All pages of wordline are programmed in order
+  PROGRAM_TWO_PASS,  //!< LSB of next wordline before upper pages
+} PROGRAM_SCHEME;
+
 typedef enum : uint8_t {
   INDEX_CHANNEL = 0x01,
   INDEX_PACKAGE = 0x02,
@@ -73,6 +121,7 @@ class Config : public BaseConfig {
     PAGETiming lsb;
     PAGETiming csb;
     PAGETiming msb;
+    PAGETiming tsb;
     DMATiming dma0;
     DMATiming dma1;
     uint64_t erase;
@@ -89,28 +138,61 @@ class Config : public BaseConfig {
     } current;
   } NANDPower;
 
+  typedef struct {
+    uint32_t wordline;    //!< First wordline of zone
+    uint32_t readScale;   //!< Unit: percent
+    uint32_t writeScale;  //!< Unit: percent
+  } NANDZone;
+
  private:
-  uint32_t channel;  //!< Default: 8
-  uint32_t package;  //!< Default: 4
-
-  uint32_t die;                 //!< Default: 2
-  uint32_t plane;               //!< Default: 1
-  uint32_t block;               //!< Default: 512
-  uint32_t page;                //!< Default: 512
-  uint32_t pageSize;            //!< Default: 16384
-  bool useMultiPlaneOperation;  //!< Default: true
-  uint32_t dmaSpeed;            //!< Default: 400
-  uint32_t dmaWidth;            //!< Default: 8
-  NAND_TYPE nandType;           //!< Default: NAND_MLC
-  uint8_t superblock;           //!< Default: All (0x0F)
-  uint8_t PageAllocation[4];    //!< Default: CWDP (0x01, 0x02, 0x04, 0x08)
+  uint32_t channel;            //!< Default: 8
+  uint32_t package;            //!< Default: 4
+  MODEL model;                 //!< Default: OLD_MODEL
+  SCHEDULER scheduler;         //!< Default: SCHEDULER_FIFO
+  uint64_t starvationLimit;    //!< Default: 5000000000 (5ms)
+  bool useSuspend;             //!< Default: false
+  uint64_t suspendLatency;     //!< Default: 20000000 (20us)
+  uint32_t maxSuspend;         //!< Default: 4
+  bool usePlaneMerge;          //!< Default: false
+  bool useCacheRead;           //!< Default: false
+  bool useCacheProgram;        //!< Default: false
+  bool useReadRetry;           //!< Default: false
+  uint32_t initialPECycle;     //!< Default: 0
+  uint32_t initialRetention;   //!< Default: 0 (hours)
+  float rberBase;              //!< Default: 0.000001
+  float rberWear;              //!< Default: 0.0001
+  float rberRetention;         //!< Default: 0.000001
+  float rberDisturb;           //!< Default: 0.00001
+  float correctableRBER;       //!< Default: 0.001
+  float retryGain;             //!< Default: 0.5
+  uint32_t maxReadRetry;       //!< Default: 8
+  uint64_t decodeLatency;      //!< Default: 2000000 (2us)
+  uint64_t softDecodeLatency;  //!< Default: 20000000 (20us)
+  STAT_LEVEL statLevel;        //!< Default: STAT_COUNTER
+
+  uint32_t die;                  //!< Default: 2
+  uint32_t plane;                //!< Default: 1
+  uint32_t block;                //!< Default: 512
+  uint32_t page;                 //!< Default: 512
+  uint32_t pageSize;             //!< Default: 16384
+  bool useMultiPlaneOperation;   //!< Default: true
+  uint32_t dmaSpeed;             //!< Default: 400
+  uint32_t dmaWidth;             //!< Default: 8
+  NAND_TYPE nandType;            //!< Default: NAND_MLC
+  PROGRAM_SCHEME programScheme;  //!< Default: PROGRAM_ONE_SHOT
+  uint8_t superblock;            //!< Default: All (0x0F)
+  uint8_t PageAllocation[4];     //!< Default: CWDP (0x01, 0x02, 0x04, 0x08)
 
   NANDTiming nandTiming;
   NANDPower nandPower;
+  std::vector<NANDZone> nandZone;
 
   // Raw variable
   std::string _superblock;
   std::string _pageAllocation;
+  std::string _wordlineZone;
+  std::string _zoneReadScale;
+  std::string _zoneWriteScale;
 
  public:
   Config();
@@ -120,6 +202,7 @@ class Config : public BaseConfig {
 
   int64_t readInt(uint32_t) override;
   uint64_t readUint(uint32_t) override;
+  float readFloat(uint32_t) override;
   bool readBoolean(uint32_t) override;
 
   uint8_t getSuperblockConfig();
@@ -127,6 +210,7 @@ class Config : public BaseConfig {
 
   NANDTiming *getNANDTiming();
   NANDPower *getNANDPower();
+  std::vector<NANDZone> *getNANDZone();
 };
 
 }  // namespace PAL
@@ -0,0 +1,1008 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pal/event_pal.hh"
+
+#include <limits>
+
+#include "pal/old/Latency.h"
+#include "pal/old/PAL2_TimeSlot.h"
+#include "pal/read_retry.hh"
+#include "util/algorithm.hh"
+
+namespace SimpleSSD {
+
+namespace PAL {
+
+EventPAL::EventPAL(Parameter &p, ConfigReader &c)
+    : AbstractPAL(p, c), commandID(0) {
+  memset(stat, 0, sizeof(stat));
+  memset(&suspendStat, 0, sizeof(suspendStat));
+  memset(&mergeStat, 0, sizeof(mergeStat));
+
+  lat = createLatency();
+
+  if (conf.readBoolean(CONFIG_PAL, PAL_USE_READ_RETRY)) {
+    readRetry = new ReadRetry(param, conf);
+  }
+  else {
+    readRetry = nullptr;
+  }
+
+  if (conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP)) {
+    planeMultiplier = param.plane;
+  }
+  else {
+    planeMultiplier = 1;
+  }
+
+  // Create channels and dies
+  channels.resize(param.channel);
+
+  for (auto &iter : channels) {
+    iter.freeSlots = new ::FreeSlotList();
+    iter.freeSlots->AddClass(1);
+    iter.startPoint = 0;
+  }
+
+  dies.resize(param.channel * param.package * param.die);
+  syncHead.resize(dies.size(), std::numeric_limits<uint32_t>::max());
+  syncList.reserve(param.pageInSuperPage);
+
+  for (uint32_t i = 0; i < dies.size(); i++) {
+    dies[i].state = DIE_IDLE;
+    dies[i].freeAt = 0;
+    dies[i].syncFreeAt = 0;
+    dies[i].syncOper = OPER_READ;
+    dies[i].syncMemAt = 0;
+    dies[i].syncMemEndAt = 0;
+    dies[i].syncReadAt = 0;
+    dies[i].syncSuspendCount = 0;
+    dies[i].suspended = false;
+    dies[i].remaining = 0;
+    dies[i].outAt = 0;
+    dies[i].cached = false;
+    dies[i].cacheRead = 0;
+    dies[i].cacheProgram = 0;
+    dies[i].event = allocate([this, i](uint64_t tick) { dieDone(i, tick); });
+    dies[i].outEvent =
+        allocate([this, i](uint64_t tick) { outDone(i, tick); });
+  }
+
+  // Select scheduler
+  starvationLimit = conf.readUint(CONFIG_PAL, PAL_STARVATION_LIMIT);
+  useSuspend = conf.readBoolean(CONFIG_PAL, PAL_USE_SUSPEND);
+  suspendLatency = conf.readUint(CONFIG_PAL, PAL_SUSPEND_LATENCY);
+  maxSuspend = conf.readUint(CONFIG_PAL, PAL_MAX_SUSPEND);
+  usePlaneMerge = conf.readBoolean(CONFIG_PAL, PAL_USE_PLANE_MERGE);
+  useCacheRead = conf.readBoolean(CONFIG_PAL, PAL_USE_CACHE_READ);
+  useCacheProgram = conf.readBoolean(CONFIG_PAL, PAL_USE_CACHE_PROGRAM);
+
+  if (usePlaneMerge && param.plane > 32) {
+    panic("Plane merge supports up to 32 planes");
+  }
+
+  switch (conf.readInt(CONFIG_PAL, PAL_SCHEDULER)) {
+    case SCHEDULER_FIFO:
+      schedulerFunction = [](Die &die, uint64_t) -> CommandIterator {
+        return die.queue.begin();
+      };
+
+      break;
+    case SCHEDULER_READ_FIRST:
+      schedulerFunction = [this](Die &die, uint64_t) -> CommandIterator {
+        return findRead(die.queue);
+      };
+
+      break;
+    case SCHEDULER_OLDEST_FIRST:
+      schedulerFunction = [this](Die &die, uint64_t tick) -> CommandIterator {
+        // Oldest command is starving
+        if (die.queue.front().arrivedAt + starvationLimit <= tick) {
+          return die.queue.begin();
+        }
+
+        return findRead(die.queue);
+      };
+
+      break;
+    default:
+      panic("Undefined PAL scheduler");
+
+      break;
+  }
+}
+
+EventPAL::~EventPAL() {
+  for (auto &iter : channels) {
+    delete iter.freeSlots;
+  }
+
+  for (auto &die : dies) {
+    if (die.state != DIE_IDLE) {
+      die.queue.push_back(die.current);
+      die.queue.insert(die.queue.end(), die.batch.begin(), die.batch.end());
+    }
+
+    if (die.suspended) {
+      die.queue.push_back(die.suspendedCommand);
+      die.queue.insert(die.queue.end(), die.suspendedBatch.begin(),
+                       die.suspendedBatch.end());
+    }
+
+    if (die.cached) {
+      die.queue.push_back(die.cachedCommand);
+    }
+
+    die.queue.insert(die.queue.end(), die.out.begin(), die.out.end());
+
+    for (auto &iter : die.queue) {
+      if (--iter.completion->remaining == 0) {
+        delete iter.completion;
+      }
+    }
+  }
+
+  delete lat;
+  delete readRetry;
+}
+
+uint32_t EventPAL::getDieIndex(::CPDPBP &addr) {
+  return (addr.Channel * param.package + addr.Package) * param.die + addr.Die;
+}
+
+uint64_t EventPAL::getLatency(Command &cmd, uint8_t busy) {
+  uint64_t latency = lat->GetLatency(cmd.addr.Page, cmd.oper, busy);
+
+  if (busy == BUSY_MEM) {
+    latency += cmd.retry;
+  }
+
+  return latency;
+}
+
+// Update block state of read-retry model, returns additional MEM time
+uint64_t EventPAL::getRetryLatency(::CPDPBP &addr, PAL_OPERATION oper,
+                                   uint64_t tick) {
+  if (!readRetry) {
+    return 0;
+  }
+
+  switch (oper) {
+    case OPER_READ:
+      return readRetry->read(addr, tick,
+                             lat->GetLatency(addr.Page, oper, BUSY_MEM));
+    case OPER_WRITE:
+      readRetry->program(addr, tick);
+
+      break;
+    default:
+      readRetry->erase(addr);
+
+      break;
+  }
+
+  return 0;
+}
+
+uint64_t EventPAL::reserveChannel(uint32_t idx, uint64_t tick, uint64_t len) {
+  Channel &channel = channels[idx];
+  uint64_t slotBeginAt;
+  uint64_t beginAt;
+  bool conflicts;
+
+  // Drop old slots here instead of periodic flush
+  if (getTick() > TIMESLOT_WINDOW) {
+    channel.freeSlots->FlushFreeSlots(getTick() - TIMESLOT_WINDOW);
+  }
+
+  if (channel.freeSlots->FindFreeTime(len, tick, slotBeginAt, conflicts)) {
+    // Use idle gap between previous reservations
+    beginAt = MAX(tick, slotBeginAt);
+  }
+  else {
+    // Append after last reservation
+    slotBeginAt = channel.startPoint;
+    beginAt = MAX(tick, slotBeginAt);
+  }
+
+  channel.freeSlots->InsertFreeSlot(len, beginAt, slotBeginAt,
+                                    channel.startPoint, false);
+
+  return beginAt;
+}
+
+EventPAL::CommandIterator EventPAL::findRead(std::list<Command> &queue) {
+  for (auto iter = queue.begin(); iter != queue.end(); iter++) {
+    if (iter->oper == OPER_READ) {
+      return iter;
+    }
+  }
+
+  return queue.begin();
+}
+
+uint64_t EventPAL::issue(SyncCommand &cmd, PAL_OPERATION oper,
+                         uint64_t tick) {
+  ::CPDPBP &addr = cmd.addr;
+  Die &die = dies[getDieIndex(addr)];
+  uint64_t beginAt = 0;
+  uint64_t dma0 = lat->GetLatency(addr.Page, oper, BUSY_DMA0) * cmd.count;
+  uint64_t mem = lat->GetLatency(addr.Page, oper, BUSY_MEM) + cmd.retry;
+  uint64_t dma1 = lat->GetLatency(addr.Page, oper, BUSY_DMA1) * cmd.count;
+  bool suspend = false;
+  bool cache = false;
+
+  // Read can suspend synchronous program/erase in MEM phase
+  if (useSuspend && oper == OPER_READ && die.syncOper != OPER_READ &&
+      die.state == DIE_IDLE && die.syncSuspendCount < maxSuspend) {
+    beginAt = MAX(tick, die.syncReadAt) + suspendLatency;
+    suspend = die.syncMemAt <= tick && beginAt < die.syncMemEndAt;
+  }
+
+  if (!suspend) {
+    beginAt = MAX(tick, MAX(die.freeAt, die.syncFreeAt));
+
+    // Overlap with previous synchronous command of same type
+    if (die.state == DIE_IDLE && die.syncOper == oper &&
+        die.syncFreeAt > tick) {
+      if (useCacheRead && oper == OPER_READ) {
+        // Cell read begins when previous data is in cache register
+        cache = true;
+        beginAt = MAX(tick, MAX(die.freeAt, die.syncMemEndAt));
+      }
+      else if (useCacheProgram && oper == OPER_WRITE) {
+        // Data-in begins when previous data leaves cache register
+        cache = true;
+        beginAt = MAX(tick, MAX(die.freeAt, die.syncMemAt));
+      }
+    }
+  }
+
+  uint64_t dma0At;
+
+  if (cache && oper == OPER_READ) {
+    // Command cycles are sent before data-out of previous read, which is
+    // already reserved on channel, so they are not reserved again
+    dma0At = beginAt;
+  }
+  else {
+    dma0At = reserveChannel(addr.Channel, beginAt, dma0);
+  }
+
+  uint64_t memAt = dma0At + dma0;
+  uint64_t dma1At = memAt + mem;
+
+  if (cache && oper == OPER_READ) {
+    // Data-out waits for data-out of previous read
+    dma1At = MAX(dma1At, die.syncFreeAt);
+    die.cacheRead++;
+  }
+  else if (cache) {
+    // Program begins after previous program
+    memAt = MAX(memAt, die.syncFreeAt);
+    dma1At = memAt + mem;
+    die.cacheProgram++;
+  }
+
+  dma1At = reserveChannel(addr.Channel, dma1At, dma1);
+
+  uint64_t finishedAt = dma1At + dma1;
+
+  if (suspend) {
+    // Suspended command resumes after read, delaying following commands
+    uint64_t delay = finishedAt - MAX(tick, die.syncReadAt);
+
+    suspendStat.count++;
+    suspendStat.savedTick += die.syncFreeAt - beginAt;
+
+    if (die.syncSuspendCount++ == 0) {
+      if (die.syncOper == OPER_WRITE) {
+        suspendStat.program++;
+      }
+      else {
+        suspendStat.erase++;
+      }
+    }
+
+    die.syncReadAt = finishedAt;
+    die.syncMemEndAt += delay;
+    die.syncFreeAt += delay;
+  }
+  else {
+    die.syncOper = oper;
+    die.syncMemAt = memAt;
+    die.syncMemEndAt = memAt + mem;
+    die.syncReadAt = 0;
+    die.syncSuspendCount = 0;
+    die.syncFreeAt = finishedAt;
+  }
+
+  mergeStat.total += cmd.count;
+
+  if (cmd.count > 1) {
+    mergeStat.count++;
+    mergeStat.commands += cmd.count;
+  }
+
+  for (uint32_t i = 0; i < cmd.count; i++) {
+    updateStat(oper, tick, beginAt, finishedAt);
+  }
+
+  return finishedAt;
+}
+
+// Add commands of request to syncList, merging them to other planes
+void EventPAL::append(Request &req, PAL_OPERATION oper, uint64_t tick) {
+  static const char name[OPER_NUM][8] = {"READ", "WRITE", "ERASE"};
+  SyncCommand cmd;
+
+  convertCPDPBP(req, addressList);
+
+  for (auto &iter : addressList) {
+    uint32_t &head = syncHead[getDieIndex(iter)];
+
+    printCPDPBP(iter, name[oper]);
+
+    cmd.addr = iter;
+    cmd.retry = getRetryLatency(iter, oper, tick);
+    cmd.planes = usePlaneMerge ? 1u << iter.Plane : 0;
+    cmd.count = 1;
+
+    if (usePlaneMerge && head < syncList.size()) {
+      SyncCommand &first = syncList[head];
+      bool merge = !(first.planes & cmd.planes);
+
+      // Same rule as queued commands, see select()
+      if (merge && oper != OPER_ERASE) {
+        merge = first.addr.Page == cmd.addr.Page && first.retry == 0 &&
+                cmd.retry == 0;
+      }
+
+      if (merge) {
+        first.planes |= cmd.planes;
+        first.count++;
+        cmd.count = 0;
+      }
+    }
+
+    if (cmd.count > 0) {
+      head = syncList.size();
+    }
+
+    syncList.push_back(cmd);
+  }
+}
+
+// Issue all commands in syncList, which arrived at tick
+void EventPAL::access(PAL_OPERATION oper, uint64_t &tick) {
+  uint64_t finishedAt = tick;
+
+  for (auto &iter : syncList) {
+    syncHead[getDieIndex(iter.addr)] = std::numeric_limits<uint32_t>::max();
+
+    // MAX evaluates its arguments twice
+    if (iter.count > 0) {
+      uint64_t doneAt = issue(iter, oper, tick);
+
+      finishedAt = MAX(finishedAt, doneAt);
+    }
+  }
+
+  syncList.clear();
+
+  tick = finishedAt;
+}
+
+void EventPAL::read(Request &req, uint64_t &tick) {
+  append(req, OPER_READ, tick);
+  access(OPER_READ, tick);
+}
+
+void EventPAL::write(Request &req, uint64_t &tick) {
+  append(req, OPER_WRITE, tick);
+  access(OPER_WRITE, tick);
+}
+
+void EventPAL::erase(Request &req, uint64_t &tick) {
+  append(req, OPER_ERASE, tick);
+  access(OPER_ERASE, tick);
+}
+
+void EventPAL::read(std::vector<Request> &list, uint64_t &tick) {
+  for (auto &iter : list) {
+    append(iter, OPER_READ, tick);
+  }
+
+  access(OPER_READ, tick);
+}
+
+void EventPAL::write(std::vector<Request> &list, uint64_t &tick) {
+  for (auto &iter : list) {
+    append(iter, OPER_WRITE, tick);
+  }
+
+  access(OPER_WRITE, tick);
+}
+
+void EventPAL::erase(std::vector<Request> &list, uint64_t &tick) {
+  for (auto &iter : list) {
+    append(iter, OPER_ERASE, tick);
+  }
+
+  access(OPER_ERASE, tick);
+}
+
+void EventPAL::submit(Request &req, PAL_OPERATION oper, DMAFunction &func,
+                      void *context) {
+  uint64_t tick = getTick();
+  Completion *completion;
+  Command cmd;
+
+  convertCPDPBP(req, addressList);
+
+  if (addressList.size() == 0) {
+    func(tick, context);
+
+    return;
+  }
+
+  completion = new Completion();
+  completion->remaining = addressList.size();
+  completion->func = func;
+  completion->context = context;
+
+  cmd.oper = oper;
+  cmd.arrivedAt = tick;
+  cmd.dispatchedAt = 0;
+  cmd.suspendCount = 0;
+  cmd.completion = completion;
+
+  for (auto &iter : addressList) {
+    uint32_t idx = getDieIndex(iter);
+
+    cmd.id = commandID++;
+    cmd.addr = iter;
+    cmd.retry = getRetryLatency(iter, oper, tick);
+
+    debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " queued to die %u", cmd.id,
+               idx);
+
+    dies[idx].queue.push_back(cmd);
+  }
+
+  // Queue all commands before dispatch, so scheduler can see them together
+  for (auto &iter : addressList) {
+    dispatch(getDieIndex(iter), tick);
+  }
+}
+
+void EventPAL::select(Die &die, CommandIterator iter, uint64_t tick) {
+  die.current = *iter;
+  die.current.dispatchedAt = tick;
+  die.queue.erase(iter);
+  die.batch.clear();
+
+  mergeStat.total++;
+
+  if (!usePlaneMerge) {
+    return;
+  }
+
+  // Collect commands to other planes, one command per plane
+  uint32_t planes = 1u << die.current.addr.Plane;
+
+  for (iter = die.queue.begin(); iter != die.queue.end();) {
+    bool merge = iter->oper == die.current.oper &&
+                 !(planes & (1u << iter->addr.Plane));
+
+    // Read/program should access same page offset in all planes
+    // Read-retry is done per plane, so only merge reads without retry
+    if (merge && iter->oper != OPER_ERASE) {
+      merge = iter->addr.Page == die.current.addr.Page && iter->retry == 0 &&
+              die.current.retry == 0;
+    }
+
+    if (merge) {
+      planes |= 1u << iter->addr.Plane;
+
+      die.batch.push_back(*iter);
+      die.batch.back().dispatchedAt = tick;
+
+      iter = die.queue.erase(iter);
+    }
+    else {
+      iter++;
+    }
+  }
+
+  if (die.batch.size() > 0) {
+    mergeStat.count++;
+    mergeStat.commands += die.batch.size() + 1;
+    mergeStat.total += die.batch.size();
+
+    debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " merged with %zu commands",
+               die.current.id, die.batch.size());
+  }
+}
+
+void EventPAL::start(Die &die, uint64_t tick) {
+  Command &cmd = die.current;
+  uint64_t planes = die.batch.size() + 1;
+  uint64_t dma0 = getLatency(cmd, BUSY_DMA0) * planes;
+  uint64_t beginAt =
+      reserveChannel(cmd.addr.Channel, MAX(tick, die.syncFreeAt), dma0);
+
+  // Estimated finish tick, fixed when DMA1 is reserved
+  die.state = DIE_DMA0;
+  die.freeAt = beginAt + dma0 + getLatency(cmd, BUSY_MEM) +
+               getLatency(cmd, BUSY_DMA1) * planes;
+
+  printCPDPBP(cmd.addr, "DMA0");
+
+  schedule(die.event, beginAt + dma0);
+}
+
+void EventPAL::dispatch(uint32_t idx, uint64_t tick) {
+  Die &die = dies[idx];
+
+  if (die.queue.size() == 0) {
+    return;
+  }
+
+  if (die.state == DIE_MEM) {
+    suspend(idx, tick);
+
+    if (die.state == DIE_MEM) {
+      cacheProgram(die, tick);
+    }
+
+    return;
+  }
+  else if (die.state != DIE_IDLE) {
+    return;
+  }
+
+  // Die is reserved by synchronous command
+  if (die.syncFreeAt > tick) {
+    if (!scheduled(die.event)) {
+      schedule(die.event, die.syncFreeAt);
+    }
+
+    return;
+  }
+
+  if (scheduled(die.event)) {
+    deschedule(die.event);
+  }
+
+  select(die, schedulerFunction(die, tick), tick);
+  start(die, tick);
+}
+
+void EventPAL::suspend(uint32_t idx, uint64_t tick) {
+  Die &die = dies[idx];
+  Command &cmd = die.current;
+  uint64_t memEndAt = 0;
+
+  // Synchronous command is reserved after current one, do not delay it
+  if (!useSuspend || cmd.oper == OPER_READ || die.suspended ||
+      cmd.suspendCount >= maxSuspend || die.syncFreeAt > tick ||
+      die.queue.size() == 0) {
+    return;
+  }
+
+  auto iter = findRead(die.queue);
+
+  if (iter->oper != OPER_READ) {
+    return;
+  }
+
+  // Suspend only when operation ends after suspend latency
+  scheduled(die.event, &memEndAt);
+
+  if (memEndAt <= tick + suspendLatency) {
+    return;
+  }
+
+  deschedule(die.event);
+
+  // Without suspend, read will begin after data-out of current command
+  // (freeAt also includes cached program, which read does not skip)
+  suspendStat.count++;
+  suspendStat.savedTick +=
+      memEndAt + getLatency(cmd, BUSY_DMA1) * (die.batch.size() + 1) - tick -
+      suspendLatency;
+
+  if (cmd.suspendCount++ == 0) {
+    if (cmd.oper == OPER_WRITE) {
+      suspendStat.program++;
+    }
+    else {
+      suspendStat.erase++;
+    }
+  }
+
+  debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " suspended (%u times)", cmd.id,
+             cmd.suspendCount);
+
+  die.suspended = true;
+  die.suspendedCommand = cmd;
+  die.suspendedBatch.swap(die.batch);
+  die.remaining = memEndAt - tick;
+
+  select(die, iter, tick);
+  start(die, tick + suspendLatency);
+
+  die.freeAt += die.remaining + getLatency(die.suspendedCommand, BUSY_DMA1) *
+                                    (die.suspendedBatch.size() + 1);
+
+  if (die.cached) {
+    die.freeAt = MAX(die.freeAt, die.cachedAt) +
+                 getLatency(die.cachedCommand, BUSY_MEM) +
+                 getLatency(die.cachedCommand, BUSY_DMA1);
+  }
+}
+
+bool EventPAL::cacheRead(Die &die, uint64_t tick) {
+  // Previous data-out is not finished, cache register is busy
+  // Next read should not run into synchronous reservation
+  if (!useCacheRead || die.suspended || die.out.size() > 0 ||
+      die.queue.size() == 0 || die.syncFreeAt > tick) {
+    return false;
+  }
+
+  auto iter = schedulerFunction(die, tick);
+
+  if (iter->oper != OPER_READ) {
+    return false;
+  }
+
+  Command &cmd = die.current;
+  uint64_t dma1 = getLatency(cmd, BUSY_DMA1) * (die.batch.size() + 1);
+
+  die.cacheRead++;
+
+  debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " cache read", cmd.id);
+
+  // Data of current read is now in cache register
+  die.out.swap(die.batch);
+  die.out.push_back(cmd);
+
+  // Issue next read first, then data-out from cache register
+  select(die, iter, tick);
+  start(die, tick);
+
+  die.outAt = reserveChannel(die.out.back().addr.Channel, tick, dma1) + dma1;
+  die.freeAt = MAX(die.freeAt, die.outAt);
+
+  schedule(die.outEvent, die.outAt);
+
+  return true;
+}
+
+void EventPAL::cacheProgram(Die &die, uint64_t tick) {
+  // Next program should not run into synchronous reservation
+  if (!useCacheProgram || die.cached || die.current.oper != OPER_WRITE ||
+      die.queue.size() == 0 || die.syncFreeAt > tick) {
+    return;
+  }
+
+  auto iter = schedulerFunction(die, tick);
+
+  if (iter->oper != OPER_WRITE) {
+    return;
+  }
+
+  Command &cmd = die.cachedCommand;
+  uint64_t dma0;
+
+  die.cacheProgram++;
+  die.cached = true;
+
+  cmd = *iter;
+  cmd.dispatchedAt = tick;
+  die.queue.erase(iter);
+
+  dma0 = getLatency(cmd, BUSY_DMA0);
+  die.cachedAt = reserveChannel(cmd.addr.Channel, tick, dma0) + dma0;
+  die.freeAt = MAX(die.freeAt, die.cachedAt) + getLatency(cmd, BUSY_MEM) +
+               getLatency(cmd, BUSY_DMA1);
+
+  debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " cache program", cmd.id);
+}
+
+void EventPAL::outDone(uint32_t idx, uint64_t tick) {
+  std::vector<Command> done;
+
+  done.swap(dies[idx].out);
+
+  for (auto &iter : done) {
+    complete(iter, tick);
+  }
+}
+
+void EventPAL::dieDone(uint32_t idx, uint64_t tick) {
+  Die &die = dies[idx];
+  Command &cmd = die.current;
+
+  switch (die.state) {
+    case DIE_IDLE:
+      dispatch(idx, tick);
+
+      break;
+    case DIE_DMA0:
+      die.state = DIE_MEM;
+
+      printCPDPBP(cmd.addr, "MEM");
+
+      schedule(die.event, tick + getLatency(cmd, BUSY_MEM));
+
+      // Read may have been queued during DMA0
+      suspend(idx, tick);
+
+      if (die.state == DIE_MEM) {
+        cacheProgram(die, tick);
+      }
+
+      break;
+    case DIE_MEM: {
+      if (cmd.oper == OPER_READ && cacheRead(die, tick)) {
+        break;
+      }
+
+      // Data of previous cache read should leave cache register first
+      uint64_t dma1 = getLatency(cmd, BUSY_DMA1) * (die.batch.size() + 1);
+      uint64_t beginAt =
+          reserveChannel(cmd.addr.Channel, MAX(tick, die.outAt), dma1);
+
+      die.state = DIE_DMA1;
+      die.freeAt = beginAt + dma1;
+
+      printCPDPBP(cmd.addr, "DMA1");
+
+      schedule(die.event, die.freeAt);
+
+      if (die.cached) {
+        die.freeAt = MAX(die.freeAt, die.cachedAt) +
+                     getLatency(die.cachedCommand, BUSY_MEM) +
+                     getLatency(die.cachedCommand, BUSY_DMA1);
+      }
+    } break;
+    case DIE_DMA1: {
+      // Callback may submit new command to this die
+      std::vector<Command> done;
+
+      done.swap(die.batch);
+      done.push_back(cmd);
+
+      if (die.suspended) {
+        // Resume suspended command
+        die.suspended = false;
+        die.current = die.suspendedCommand;
+        die.batch.swap(die.suspendedBatch);
+        die.state = DIE_MEM;
+        die.freeAt = tick + die.remaining +
+                     getLatency(die.current, BUSY_DMA1) *
+                         (die.batch.size() + 1);
+
+        debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " resumed",
+                   die.current.id);
+
+        schedule(die.event, tick + die.remaining);
+      }
+      else if (die.cached) {
+        // Data of next program is already in cache register
+        uint64_t beginAt = MAX(tick, die.cachedAt);
+
+        die.cached = false;
+        die.current = die.cachedCommand;
+        die.state = DIE_DMA0;
+        die.freeAt = beginAt + getLatency(die.current, BUSY_MEM) +
+                     getLatency(die.current, BUSY_DMA1);
+
+        schedule(die.event, beginAt);
+      }
+      else {
+        die.state = DIE_IDLE;
+      }
+
+      for (auto &iter : done) {
+        complete(iter, tick);
+      }
+
+      dispatch(idx, tick);
+    } break;
+  }
+}
+
+void EventPAL::complete(Command &cmd, uint64_t tick) {
+  Completion *completion = cmd.completion;
+
+  debugprint(LOG_PAL_EVENT, "Command %" PRIu64 " finished", cmd.id);
+
+  updateStat(cmd.oper, cmd.arrivedAt, cmd.dispatchedAt, tick);
+
+  if (--completion->remaining == 0) {
+    completion->func(tick, completion->context);
+
+    delete completion;
+  }
+}
+
+void EventPAL::updateStat(PAL_OPERATION oper, uint64_t arrivedAt,
+                          uint64_t dispatchedAt, uint64_t finishedAt) {
+  stat[oper].count++;
+  stat[oper].waitTick += dispatchedAt - arrivedAt;
+  stat[oper].totalTick += finishedAt - arrivedAt;
+}
+
+void EventPAL::printCPDPBP(::CPDPBP &addr, const char *prefix) {
+  debugprint(LOG_PAL_EVENT,
+             "%-5s | C %5u | W %5u | D %5u | P %5u | B %5u | P %5u", prefix,
+             addr.Channel, addr.Package, addr.Die, addr.Plane, addr.Block,
+             addr.Page);
+}
+
+void EventPAL::getStatList(std::vector<Stats> &list, std::string prefix) {
+  static const char name[OPER_NUM][8] = {"read", "program", "erase"};
+  Stats temp;
+
+  for (int i = 0; i < OPER_NUM; i++) {
+    temp.name = prefix + name[i] + ".count";
+    temp.desc = std::string("Total ") + name[i] + " operation count";
+    list.push_back(temp);
+
+    temp.name = prefix + name[i] + ".bytes";
+    temp.desc = std::string("Total ") + name[i] + " operation bytes";
+    list.push_back(temp);
+
+    temp.name = prefix + name[i] + ".time.wait";
+    temp.desc = std::string("Average queue wait time of ") + name[i];
+    list.push_back(temp);
+
+    temp.name = prefix + name[i] + ".time.total";
+    temp.desc = std::string("Average time of ") + name[i];
+    list.push_back(temp);
+  }
+
+  if (useSuspend) {
+    temp.name = prefix + "suspend.count";
+    temp.desc = "Total program/erase suspend count";
+    list.push_back(temp);
+
+    temp.name = prefix + "suspend.program";
+    temp.desc = "Total program operations suspended at least once";
+    list.push_back(temp);
+
+    temp.name = prefix + "suspend.erase";
+    temp.desc = "Total erase operations suspended at least once";
+    list.push_back(temp);
+
+    temp.name = prefix + "suspend.saved";
+    temp.desc = "Average read latency saved by suspend";
+    list.push_back(temp);
+  }
+
+  if (usePlaneMerge) {
+    temp.name = prefix + "merge.count";
+    temp.desc = "Total multi-plane commands made by merge";
+    list.push_back(temp);
+
+    temp.name = prefix + "merge.rate";
+    temp.desc = "Ratio of commands served by merged multi-plane command";
+    list.push_back(temp);
+  }
+
+  if (useCacheRead || useCacheProgram) {
+    std::string number;
+
+    for (uint32_t i = 0; i < dies.size(); i++) {
+      number = std::to_string(i);
+
+      temp.name = prefix + "die" + number + ".cache_read";
+      temp.desc = "Total reads overlapped with previous read by cache read";
+      list.push_back(temp);
+
+      temp.name = prefix + "die" + number + ".cache_program";
+      temp.desc = "Total programs loaded to cache register during program";
+      list.push_back(temp);
+    }
+  }
+
+  if (readRetry) {
+    readRetry->getStatList(list, prefix);
+  }
+}
+
+void EventPAL::getStatValues(std::vector<double> &values) {
+  for (int i = 0; i < OPER_NUM; i++) {
+    uint64_t bytes = stat[i].count * param.pageSize * planeMultiplier;
+
+    if (i == OPER_ERASE) {
+      bytes *= param.page;
+    }
+
+    values.push_back(stat[i].count);
+    values.push_back(bytes);
+
+    if (stat[i].count > 0) {
+      values.push_back((double)stat[i].waitTick / stat[i].count);
+      values.push_back((double)stat[i].totalTick / stat[i].count);
+    }
+    else {
+      values.push_back(0);
+      values.push_back(0);
+    }
+  }
+
+  if (useSuspend) {
+    values.push_back(suspendStat.count);
+    values.push_back(suspendStat.program);
+    values.push_back(suspendStat.erase);
+
+    if (suspendStat.count > 0) {
+      values.push_back((double)suspendStat.savedTick / suspendStat.count);
+    }
+    else {
+      values.push_back(0);
+    }
+  }
+
+  if (usePlaneMerge) {
+    values.push_back(mergeStat.count);
+
+    if (mergeStat.total > 0) {
+      values.push_back((double)mergeStat.commands / mergeStat.total);
+    }
+    else {
+      values.push_back(0);
+    }
+  }
+
+  if (useCacheRead || useCacheProgram) {
+    for (auto &die : dies) {
+      values.push_back(die.cacheRead);
+      values.push_back(die.cacheProgram);
+    }
+  }
+
+  if (readRetry) {
+    readRetry->getStatValues(values);
+  }
+}
+
+void EventPAL::resetStatValues() {
+  memset(stat, 0, sizeof(stat));
+  memset(&suspendStat, 0, sizeof(suspendStat));
+  memset(&mergeStat, 0, sizeof(mergeStat));
+
+  for (auto &die : dies) {
+    die.cacheRead = 0;
+    die.cacheProgram = 0;
+  }
+
+  if (readRetry) {
+    readRetry->resetStatValues();
+  }
+}
+
+}  // namespace PAL
+
+}  // namespace SimpleSSD
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PAL_EVENT_PAL__
+#define __PAL_EVENT_PAL__
+
+#include <cinttypes>
+#include <functional>
+#include <list>
+#include <vector>
+
+#include "pal/abstract_pal.hh"
+
+class FreeSlotList;
+class Latency;
+
+namespace SimpleSSD {
+
+namespace PAL {
+
+class ReadRetry;
+
+/**
+ * \brief Event-driven PAL
+ *
+ * Each die has its own command queue, and one command is in flight per die.
+ * A command goes through DMA0 (command/data in), MEM (cell operation) and
+ * DMA1 (data out/status) phases, which are driven by simulator events.
+ * Channel DMA is arbitrated with a free-slot timeline per channel, so DMA of
+ * one die can use the channel while other dies are in MEM phase.
+ *
+ * Commands submitted through submit() are queued and selected by scheduler.
+ * Synchronous read/write/erase calls must return finish tick immediately, so
+ * they reserve die and channel in arrival order and never wait in queue.
+ * They begin after the command in flight, and queued commands are not started,
+ * suspended or cached until the synchronous reservation is over.
+ *
+ * When suspend is enabled, queued read can suspend program/erase in MEM
+ * phase. The read is served, then suspended command resumes its remaining
+ * MEM phase. Synchronous read can suspend synchronous program/erase in the
+ * same way, but finish tick of suspended command is already returned, so only
+ * commands after it are delayed.
+ *
+ * When plane merge is enabled, queued commands of same type to other planes
+ * of the die are served together with selected command as one multi-plane
+ * command. DMA time is multiplied by # planes, MEM time is not. Synchronous
+ * commands arriving in one call are merged in the same way.
+ *
+ * Cache read starts MEM phase of next read when data of current read is
+ * moved to cache register, so DMA1 of current read runs in background.
+ * Cache program loads data of next program to cache register (DMA0) while
+ * current program is in MEM phase. Both apply to queued commands, and to a
+ * synchronous command following synchronous command of same type.
+ */
+class EventPAL : public AbstractPAL {
+ private:
+  typedef enum {
+    DIE_IDLE,
+    DIE_DMA0,
+    DIE_MEM,
+    DIE_DMA1,
+  } DIE_STATE;
+
+  // Shared by all commands generated from one request
+  struct Completion {
+    uint32_t remaining;  //!< # commands not finished yet
+    DMAFunction func;
+    void *context;
+  };
+
+  struct Command {
+    uint64_t id;
+    PAL_OPERATION oper;
+    ::CPDPBP addr;
+
+    uint64_t arrivedAt;     //!< Command inserted to die queue
+    uint64_t dispatchedAt;  //!< Command selected by scheduler
+
+    uint32_t suspendCount;
+    uint64_t retry;  //!< Read-retry and ECC decode time added to MEM
+
+    Completion *completion;
+  };
+
+  // Synchronous command, may be merged with commands to other planes
+  struct SyncCommand {
+    ::CPDPBP addr;
+    uint64_t retry;
+
+    uint32_t planes;  //!< Bitmap of planes served by this command
+    uint32_t count;   //!< # planes, 0 if merged to other command
+  };
+
+  struct Die {
+    DIE_STATE state;
+    uint64_t freeAt;      //!< Queued commands occupy die until this tick
+    uint64_t syncFreeAt;  //!< Synchronous commands occupy die until this tick
+
+    // Last synchronous command, for suspend/cache by next synchronous one
+    PAL_OPERATION syncOper;
+    uint64_t syncMemAt;         //!< MEM phase begins
+    uint64_t syncMemEndAt;      //!< MEM phase ends, delayed by suspend
+    uint64_t syncReadAt;        //!< Read suspending it is finished
+    uint32_t syncSuspendCount;  //!< # suspends
+
+    std::list<Command> queue;
+    Command current;
+    std::vector<Command> batch;  //!< Merged to current (other planes)
+
+    bool suspended;
+    Command suspendedCommand;
+    std::vector<Command> suspendedBatch;
+    uint64_t remaining;  //!< Remaining MEM time of suspended command
+
+    std::vector<Command> out;  //!< Cache read, data-out in progress
+    uint64_t outAt;            //!< Cache register is free after this tick
+
+    bool cached;
+    Command cachedCommand;  //!< Cache program, data-in done or in progress
+    uint64_t cachedAt;      //!< Data-in of cachedCommand is finished
+
+    uint64_t cacheRead;     //!< # reads overlapped by cache read
+    uint64_t cacheProgram;  //!< # programs overlapped by cache program
+
+    Event event;
+    Event outEvent;
+  };
+
+  struct Channel {
+    ::FreeSlotList *freeSlots;
+    uint64_t startPoint;  //!< Channel is not reserved after this tick
+  };
+
+  typedef std::list<Command>::iterator CommandIterator;
+  typedef std::function<CommandIterator(Die &, uint64_t)> SchedulerFunction;
+
+  ::Latency *lat;
+  ReadRetry *readRetry;
+
+  std::vector<Channel> channels;
+  std::vector<Die> dies;
+
+  SchedulerFunction schedulerFunction;
+  uint64_t starvationLimit;
+
+  bool useSuspend;
+  uint64_t suspendLatency;
+  uint32_t maxSuspend;
+
+  bool usePlaneMerge;
+  bool useCacheRead;
+  bool useCacheProgram;
+
+  std::vector<SyncCommand> syncList;  //!< Arrived in one call
+  std::vector<uint32_t> syncHead;     //!< Index of last command per die
+
+  uint64_t commandID;
+  uint64_t planeMultiplier;
+
+  struct {
+    uint64_t count;
+    uint64_t waitTick;   //!< Sum of queue wait time
+    uint64_t totalTick;  //!< Sum of command latency
+  } stat[OPER_NUM];
+
+  struct {
+    uint64_t count;
+    uint64_t program;  //!< # programs suspended at least once
+    uint64_t erase;    //!< # erases suspended at least once
+    uint64_t savedTick;
+  } suspendStat;
+
+  struct {
+    uint64_t count;     //!< # multi-plane commands made by merge
+    uint64_t commands;  //!< # commands served by merged command
+    uint64_t total;     //!< # commands dispatched
+  } mergeStat;
+
+  uint32_t getDieIndex(::CPDPBP &);
+  uint64_t getLatency(Command &, uint8_t);
+  uint64_t getRetryLatency(::CPDPBP &, PAL_OPERATION, uint64_t);
+  uint64_t reserveChannel(uint32_t, uint64_t, uint64_t);
+
+  CommandIterator findRead(std::list<Command> &);
+
+  uint64_t issue(SyncCommand &, PAL_OPERATION, uint64_t);
+  void append(Request &, PAL_OPERATION, uint64_t);
+  void access(PAL_OPERATION, uint64_t &);
+
+  void select(Die &, CommandIterator, uint64_t);
+  void start(Die &, uint64_t);
+  void dispatch(uint32_t, uint64_t);
+  void suspend(uint32_t, uint64_t);
+  bool cacheRead(Die &, uint64_t);
+  void cacheProgram(Die &, uint64_t);
+  void outDone(uint32_t, uint64_t);
+  void dieDone(uint32_t, uint64_t);
+  void complete(Command &, uint64_t);
+
+  void updateStat(PAL_OPERATION, uint64_t, uint64_t, uint64_t);
+  void printCPDPBP(::CPDPBP &, const char *);
+
+ public:
+  EventPAL(Parameter &, ConfigReader &);
+  ~EventPAL();
+
+  void read(Request &, uint64_t &) override;
+  void write(Request &, uint64_t &) override;
+  void erase(Request &, uint64_t &) override;
+
+  void read(std::vector<Request> &, uint64_t &) override;
+  void write(std::vector<Request> &, uint64_t &) override;
+  void erase(std::vector<Request> &, uint64_t &) override;
+
+  void submit(Request &, PAL_OPERATION, DMAFunction &,
+              void * = nullptr) override;
+
+  void getStatList(std::vector<Stats> &, std::string) override;
+  void getStatValues(std::vector<double> &) override;
+  void resetStatValues() override;
+};
+
+}  // namespace PAL
+
+}  // namespace SimpleSSD
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyTable.h"
+
+#include "sim/trace.hh"
+
+// Page type of n-th bit in cell, indexed by bits per cell
+static const uint8_t bitType[5][4] = {
+    {PAGE_LSB, PAGE_LSB, PAGE_LSB, PAGE_LSB},
+    {PAGE_LSB, PAGE_LSB, PAGE_LSB, PAGE_LSB},
+    {PAGE_LSB, PAGE_MSB, PAGE_MSB, PAGE_MSB},
+    {PAGE_LSB, PAGE_CSB, PAGE_MSB, PAGE_MSB},
+    {PAGE_LSB, PAGE_CSB, PAGE_MSB, PAGE_TSB},
+};
+
+LatencyTable::LatencyTable(SimpleSSD::PAL::Config::NANDTiming t,
+                           SimpleSSD::PAL::Config::NANDPower p,
+                           uint32_t pages, uint32_t bits,
+                           SimpleSSD::PAL::PROGRAM_SCHEME scheme,
+                           std::vector<SimpleSSD::PAL::Config::NANDZone> &zone)
+    : Latency(t, p) {
+  SimpleSSD::PAL::Config::PAGETiming *pTiming;
+  uint32_t wordlines;
+  uint32_t wordline;
+  uint32_t bit;
+  uint32_t read;
+  uint32_t write;
+
+  if (bits == 0 || bits > 4) {
+    SimpleSSD::panic("Invalid bits per cell");
+  }
+  if (pages % bits) {
+    SimpleSSD::panic("# pages per block should be multiple of bits per cell");
+  }
+
+  wordlines = pages / bits;
+
+  pageType.resize(pages);
+  readLatency.resize(pages);
+  writeLatency.resize(pages);
+
+  for (uint32_t i = 0; i < pages; i++) {
+    // Find wordline and bit index of page
+    if (scheme == SimpleSSD::PAL::PROGRAM_TWO_PASS && bits > 1) {
+      // LSB of wordline k + 1 is programmed before upper pages of wordline k
+      // 0: WL0 LSB, 1: WL1 LSB, 2 ~ bits: WL0 upper, bits + 1: WL2 LSB ...
+      if (i == 0) {
+        wordline = 0;
+        bit = 0;
+      }
+      else {
+        uint32_t j = i - 1;
+        uint32_t k = j / bits + 1;
+
+        if (k < wordlines) {
+          if (j % bits == 0) {
+            wordline = k;
+            bit = 0;
+          }
+          else {
+            wordline = k - 1;
+            bit = j % bits;
+          }
+        }
+        else {
+          wordline = wordlines - 1;
+          bit = j - (wordlines - 1) * bits + 1;
+        }
+      }
+    }
+    else {
+      wordline = i / bits;
+      bit = i % bits;
+    }
+
+    pageType[i] = bitType[bits][bit];
+
+    // Find zone of wordline
+    read = 100;
+    write = 100;
+
+    for (auto &iter : zone) {
+      if (iter.wordline > wordline) {
+        break;
+      }
+
+      read = iter.readScale;
+      write = iter.writeScale;
+    }
+
+    switch (pageType[i]) {
+      case PAGE_LSB:
+        pTiming = &timing.lsb;
+        break;
+      case PAGE_CSB:
+        pTiming = &timing.csb;
+        break;
+      case PAGE_MSB:
+        pTiming = &timing.msb;
+        break;
+      default:
+        pTiming = &timing.tsb;
+        break;
+    }
+
+    readLatency[i] = pTiming->read * read / 100;
+    writeLatency[i] = pTiming->write * write / 100;
+  }
+}
+
+LatencyTable::~LatencyTable() {}
+
+uint8_t LatencyTable::GetPageType(uint32_t AddrPage) {
+  return pageType[AddrPage];
+}
+
+uint64_t LatencyTable::GetLatency(uint32_t AddrPage, uint8_t Oper,
+                                  uint8_t Busy) {
+  switch (Busy) {
+    case BUSY_DMA0:
+      if (Oper == OPER_READ) {
+        return timing.dma0.read;
+      }
+      else if (Oper == OPER_WRITE) {
+        return timing.dma0.write;
+      }
+      else {
+        return timing.dma0.erase;
+      }
+
+      break;
+    case BUSY_DMA1:
+      if (Oper == OPER_READ) {
+        return timing.dma1.read;
+      }
+      else if (Oper == OPER_WRITE) {
+        return timing.dma1.write;
+      }
+      else {
+        return timing.dma1.erase;
+      }
+
+      break;
+    case BUSY_MEM:
+      if (Oper == OPER_READ) {
+        return readLatency[AddrPage];
+      }
+      else if (Oper == OPER_WRITE) {
+        return writeLatency[AddrPage];
+      }
+      else {
+        return timing.erase;
+      }
+
+      break;
+    default:
+      break;
+  }
+
+  return 10;
+}
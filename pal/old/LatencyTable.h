@@ -0,0 +1,45 @@
+/**
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LatencyTable_h__
+#define __LatencyTable_h__
+
+#include <vector>
+
+#include "Latency.h"
+
+// Table driven latency model
+// Page type and MEM latency of each page in block are calculated once from
+// bits per cell, program scheme and wordline zones.
+class LatencyTable : public Latency {
+ private:
+  std::vector<uint8_t> pageType;
+  std::vector<uint64_t> readLatency;
+  std::vector<uint64_t> writeLatency;
+
+ public:
+  LatencyTable(SimpleSSD::PAL::Config::NANDTiming,
+               SimpleSSD::PAL::Config::NANDPower, uint32_t, uint32_t,
+               SimpleSSD::PAL::PROGRAM_SCHEME,
+               std::vector<SimpleSSD::PAL::Config::NANDZone> &);
+  ~LatencyTable();
+
+  uint64_t GetLatency(uint32_t, uint8_t, uint8_t) override;
+  uint8_t GetPageType(uint32_t) override;
+};
+
+#endif  //__LatencyTable_h__
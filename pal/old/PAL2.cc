@@ -19,6 +19,8 @@
 
 #include "PAL2.h"
 
+#include <algorithm>
+
 #include "util/algorithm.hh"
 
 PAL2::PAL2(PALStatistics *statistics, SimpleSSD::PAL::Parameter *p,
@@ -69,58 +71,41 @@ PAL2::PAL2(PALStatistics *statistics, SimpleSSD::PAL::Parameter *p,
 
   totalDie = pParam->channel * pParam->package * pParam->die;
 
-  ChFreeSlots =
-      new std::map<uint64_t, std::map<uint64_t, uint64_t> *>[pParam->channel];
+  ChFreeSlots = new FreeSlotList[pParam->channel];
   ChStartPoint = new uint64_t[pParam->channel];
   for (unsigned i = 0; i < pParam->channel; i++)
     ChStartPoint[i] = 0;
 
-  DieFreeSlots =
-      new std::map<uint64_t, std::map<uint64_t, uint64_t> *>[totalDie];
+  DieFreeSlots = new FreeSlotList[totalDie];
   DieStartPoint = new uint64_t[totalDie];
   for (unsigned i = 0; i < totalDie; i++)
     DieStartPoint[i] = 0;
 
   // currently, hard code pre-dma, mem-op and post-dma values
   for (unsigned i = 0; i < pParam->channel; i++) {
-    std::map<uint64_t, uint64_t> *tmp;
     switch (
         c->readUint(SimpleSSD::CONFIG_PAL, SimpleSSD::PAL::NAND_FLASH_TYPE)) {
       case SimpleSSD::PAL::NAND_SLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV)] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV) + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][1500000 / SPDIV] = tmp;
+        ChFreeSlots[i].AddClass(100000 / SPDIV);
+        ChFreeSlots[i].AddClass(100000 / SPDIV + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV));
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV) + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(1500000 / SPDIV);
         break;
       case SimpleSSD::PAL::NAND_MLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV)] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV) + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][1500000 / SPDIV] = tmp;
+        ChFreeSlots[i].AddClass(100000 / SPDIV);
+        ChFreeSlots[i].AddClass(100000 / SPDIV + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV));
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV) + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(1500000 / SPDIV);
         break;
       case SimpleSSD::PAL::NAND_TLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][100000 / SPDIV + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV)] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][185000000 / (PGDIV * SPDIV) + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        ChFreeSlots[i][1500000 / SPDIV] = tmp;
+      case SimpleSSD::PAL::NAND_QLC:
+        ChFreeSlots[i].AddClass(100000 / SPDIV);
+        ChFreeSlots[i].AddClass(100000 / SPDIV + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV));
+        ChFreeSlots[i].AddClass(185000000 / (PGDIV * SPDIV) + 100000 / SPDIV);
+        ChFreeSlots[i].AddClass(1500000 / SPDIV);
         break;
       default:
         printf("unsupported NAND types!\n");
@@ -130,45 +115,44 @@ PAL2::PAL2(PALStatistics *statistics, SimpleSSD::PAL::Parameter *p,
   }
 
   for (unsigned i = 0; i < totalDie; i++) {
-    std::map<uint64_t, uint64_t> *tmp;
     switch (
         c->readUint(SimpleSSD::CONFIG_PAL, SimpleSSD::PAL::NAND_FLASH_TYPE)) {
       case SimpleSSD::PAL::NAND_SLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][25000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][300000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][2000000000 + 100000 / SPDIV] = tmp;
+        DieFreeSlots[i].AddClass(25000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(300000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(2000000000 + 100000 / SPDIV);
         break;
       case SimpleSSD::PAL::NAND_MLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][40000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][90000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][500000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][1300000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][3500000000 + 100000 / SPDIV] = tmp;
+        DieFreeSlots[i].AddClass(40000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(90000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(500000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(1300000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(3500000000 + 100000 / SPDIV);
         break;
       case SimpleSSD::PAL::NAND_TLC:
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][58000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][78000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][107000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][558000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][2201000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][5001000000 + 100000 / SPDIV] = tmp;
-        tmp = new std::map<uint64_t, uint64_t>;
-        DieFreeSlots[i][2274000000 + 100000 / SPDIV] = tmp;
+        DieFreeSlots[i].AddClass(58000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(78000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(107000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(558000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(2201000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(5001000000 + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(2274000000 + 100000 / SPDIV);
+        break;
+      case SimpleSSD::PAL::NAND_QLC: {
+        // No hard coded values, use configured timing
+        SimpleSSD::PAL::Config::NANDTiming *pTiming = c->getNANDTiming();
+
+        DieFreeSlots[i].AddClass(pTiming->lsb.read + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->csb.read + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->msb.read + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->tsb.read + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->lsb.write + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->csb.write + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->msb.write + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->tsb.write + 100000 / SPDIV);
+        DieFreeSlots[i].AddClass(pTiming->erase + 100000 / SPDIV);
         break;
+      }
       default:
         printf("unsupported NAND types!\n");
         std::terminate();
@@ -180,24 +164,7 @@ PAL2::PAL2(PALStatistics *statistics, SimpleSSD::PAL::Parameter *p,
 PAL2::~PAL2() {
   FlushTimeSlots(MAX64);
 
-  for (uint i = 0; i < pParam->channel; i++) {
-    for (auto &iter : ChFreeSlots[i]) {
-      {
-        delete iter.second;
-        iter.second = NULL;
-      }
-    }
-  }
   delete[] ChFreeSlots;
-
-  for (uint i = 0; i < totalDie; i++) {
-    for (auto &iter : DieFreeSlots[i]) {
-      {
-        delete iter.second;
-        iter.second = NULL;
-      }
-    }
-  }
   delete[] DieFreeSlots;
 
   delete[] ChStartPoint;
@@ -207,6 +174,20 @@ PAL2::~PAL2() {
 void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
   // ensure we can erase multiple blocks from single request
   unsigned erase_block = 1;
+
+  // Drop old slots here instead of periodic flush
+  if (req.arrived > TIMESLOT_WINDOW) {
+    uint64_t flushTick = req.arrived - TIMESLOT_WINDOW;
+
+    ChFreeSlots[reqCPD.Channel].FlushFreeSlots(flushTick);
+    DieFreeSlots[CPDPBPtoDieIdx(&reqCPD)].FlushFreeSlots(flushTick);
+
+    if (MergedTimeSlots.size() > 0 &&
+        MergedTimeSlots.front().EndTick < flushTick) {
+      FlushATimeSlotBusyTime(MergedTimeSlots, flushTick,
+                             &(stats->ExactBusyTime));
+    }
+  }
   /*=========== CONFLICT data gather ============*/
   for (unsigned cur_command = 0; cur_command < erase_block; cur_command++) {
 #if GATHER_RESOURCE_CONFLICT
@@ -223,7 +204,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
     uint64_t latANTI;                                  // anticipate time slot
     bool conflicts;  // check conflict when scheduling
     latDMA0 = lat->GetLatency(reqCPD.Page, req.operation, BUSY_DMA0);
-    latMEM = lat->GetLatency(reqCPD.Page, req.operation, BUSY_MEM);
+    latMEM = lat->GetLatency(reqCPD.Page, req.operation, BUSY_MEM) +
+             req.retryLatency;
     latDMA1 = lat->GetLatency(reqCPD.Page, req.operation, BUSY_DMA1);
     latANTI = lat->GetLatency(reqCPD.Page, OPER_READ, BUSY_DMA0);
     // Start Finding available Slot
@@ -233,8 +215,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
       while (1)  // LOOP1
       {
         // 1a) LOOP1 - Find DMA0 available slot in ChTimeSlots
-        if (!FindFreeTime(ChFreeSlots[reqCh], latDMA0, DMA0tickFrom, tickDMA0,
-                          conflicts)) {
+        if (!ChFreeSlots[reqCh].FindFreeTime(latDMA0, DMA0tickFrom, tickDMA0,
+                                             conflicts)) {
           if (DMA0tickFrom < ChStartPoint[reqCh]) {
             DMA0tickFrom = ChStartPoint[reqCh];
             conflicts = true;
@@ -256,8 +238,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
 
         // 2b) LOOP1 - Find MEM avaiable slot in DieTimeSlots
         MEMtickFrom = DMA0tickFrom;
-        if (!FindFreeTime(DieFreeSlots[reqDieIdx], (latDMA0 + latMEM),
-                          MEMtickFrom, tickMEM, conflicts)) {
+        if (!DieFreeSlots[reqDieIdx].FindFreeTime(
+                (latDMA0 + latMEM), MEMtickFrom, tickMEM, conflicts)) {
           if (MEMtickFrom < DieStartPoint[reqDieIdx]) {
             MEMtickFrom = DieStartPoint[reqDieIdx];
             conflicts = true;
@@ -276,8 +258,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
         DMA0tickFrom = MEMtickFrom;
 
         uint64_t tickDMA0_vrfy;
-        if (!FindFreeTime(ChFreeSlots[reqCh], latDMA0, DMA0tickFrom,
-                          tickDMA0_vrfy, conflicts)) {
+        if (!ChFreeSlots[reqCh].FindFreeTime(latDMA0, DMA0tickFrom,
+                                             tickDMA0_vrfy, conflicts)) {
           tickDMA0_vrfy = ChStartPoint[reqCh];
         }
         if (tickDMA0_vrfy == tickDMA0)
@@ -293,8 +275,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
 
       // 3) Find DMA1 available slot
       DMA1tickFrom = DMA0tickFrom + (latDMA0 + latMEM);
-      if (!FindFreeTime(ChFreeSlots[reqCh], latDMA1 + latANTI, DMA1tickFrom,
-                        tickDMA1, conflicts)) {
+      if (!ChFreeSlots[reqCh].FindFreeTime(latDMA1 + latANTI, DMA1tickFrom,
+                                           tickDMA1, conflicts)) {
         if (DMA1tickFrom < ChStartPoint[reqCh]) {
           DMA1tickFrom = ChStartPoint[reqCh];
           conflicts = true;
@@ -312,8 +294,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
       // The target die should be free during (DMA0_start ~ DMA1_end)
       totalLat = (DMA1tickFrom + latDMA1 + latANTI) - DMA0tickFrom;
       uint64_t tickMEM_vrfy;
-      if (!FindFreeTime(DieFreeSlots[reqDieIdx], totalLat, DMA0tickFrom,
-                        tickMEM_vrfy, conflicts)) {
+      if (!DieFreeSlots[reqDieIdx].FindFreeTime(totalLat, DMA0tickFrom,
+                                                tickMEM_vrfy, conflicts)) {
         tickMEM_vrfy = DieStartPoint[reqDieIdx];
       }
       if (tickMEM_vrfy == tickMEM)
@@ -328,11 +310,11 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
 
     // 5) Assign dma0, dma1, mem
     {
-      InsertFreeSlot(ChFreeSlots[reqCh], latDMA0, DMA0tickFrom, tickDMA0,
-                     ChStartPoint[reqCh], 0);
+      ChFreeSlots[reqCh].InsertFreeSlot(latDMA0, DMA0tickFrom, tickDMA0,
+                                        ChStartPoint[reqCh], 0);
 
-      if (!FindFreeTime(ChFreeSlots[reqCh], latDMA1 + latANTI, DMA1tickFrom,
-                        tickDMA1, conflicts)) {
+      if (!ChFreeSlots[reqCh].FindFreeTime(latDMA1 + latANTI, DMA1tickFrom,
+                                           tickDMA1, conflicts)) {
         if (DMA1tickFrom < ChStartPoint[reqCh]) {
           DMA1tickFrom = ChStartPoint[reqCh];
           conflicts = true;
@@ -346,15 +328,15 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
           DMA1tickFrom = tickDMA1;
       }
       if (DMA1tickFrom > tickDMA1)
-        InsertFreeSlot(ChFreeSlots[reqCh], latDMA1, DMA1tickFrom + latANTI,
-                       tickDMA1, ChStartPoint[reqCh], 0);
+        ChFreeSlots[reqCh].InsertFreeSlot(latDMA1, DMA1tickFrom + latANTI,
+                                          tickDMA1, ChStartPoint[reqCh], 0);
       else
-        InsertFreeSlot(ChFreeSlots[reqCh], latDMA1, tickDMA1 + latANTI,
-                       tickDMA1, ChStartPoint[reqCh], 0);
+        ChFreeSlots[reqCh].InsertFreeSlot(latDMA1, tickDMA1 + latANTI,
+                                          tickDMA1, ChStartPoint[reqCh], 0);
 
       // temporarily use previous MergedTimeSlots design
-      InsertFreeSlot(DieFreeSlots[reqDieIdx], totalLat, DMA0tickFrom, tickMEM,
-                     DieStartPoint[reqDieIdx], 0);
+      DieFreeSlots[reqDieIdx].InsertFreeSlot(totalLat, DMA0tickFrom, tickMEM,
+                                             DieStartPoint[reqDieIdx], 0);
 
       if (DMA0tickFrom < tickDMA0)
         tsDMA0 = TimeSlot(tickDMA0, latDMA0);
@@ -377,8 +359,8 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
       else
         DMA0tickFrom = tickDMA0 + latDMA0;
       uint64_t tmpTick = DMA0tickFrom;
-      if (!FindFreeTime(ChFreeSlots[reqCh], latANTI * 2, DMA0tickFrom, tickDMA0,
-                        conflicts)) {
+      if (!ChFreeSlots[reqCh].FindFreeTime(latANTI * 2, DMA0tickFrom,
+                                           tickDMA0, conflicts)) {
         if (DMA0tickFrom < ChStartPoint[reqCh]) {
           DMA0tickFrom = ChStartPoint[reqCh];
           conflicts = true;
@@ -392,132 +374,12 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
           DMA0tickFrom = tickDMA0;
       }
       if (DMA0tickFrom == tmpTick)
-        InsertFreeSlot(ChFreeSlots[reqCh], latANTI * 2, DMA0tickFrom, tickDMA0,
-                       ChStartPoint[reqCh], 1);
-        //******************************************************************//
-#if 1
-      // Manage MergedTimeSlots
-      if (MergedTimeSlots.size() == 0) {
-        MergedTimeSlots.push_back(
-            TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
-      }
-      else {
-        uint64_t s = tsMEM.StartTick;
-        uint64_t e = tsMEM.EndTick;
-        int spnt = 0, epnt = 0;  // inside(0), rightside(1)
-        std::list<TimeSlot>::iterator cur;
-        std::list<TimeSlot>::iterator spos = MergedTimeSlots.end();
-        std::list<TimeSlot>::iterator epos = MergedTimeSlots.end();
-
-        // find s position
-        cur = MergedTimeSlots.begin();
-
-        while (cur != MergedTimeSlots.end()) {
-          if (cur->StartTick <= s && s <= cur->EndTick) {
-            spos = cur;
-            spnt = 0;  // inside
-            break;
-          }
-
-          auto next = cur;
-
-          next++;
-
-          if ((next == MergedTimeSlots.end()) ||
-              (next != MergedTimeSlots.end() && (s < next->StartTick))) {
-            spos = cur;
-            spnt = 1;  // rightside
-            break;
-          }
-
-          cur = next;
-        }
-
-        // find e position
-        cur = MergedTimeSlots.begin();
-
-        while (cur != MergedTimeSlots.end()) {
-          if (cur->StartTick <= e && e <= cur->EndTick) {
-            epos = cur;
-            epnt = 0;  // inside
-            break;
-          }
-
-          auto next = cur;
-
-          next++;
-
-          if ((next == MergedTimeSlots.end()) ||
-              (next != MergedTimeSlots.end() && (e < next->StartTick))) {
-            epos = cur;
-            epnt = 1;  // rightside
-            break;
-          }
-
-          cur = next;
-        }
-
-        // merge
-        // if both side is in a merged slot, skip
-        if (!(spos != MergedTimeSlots.end() && epos != MergedTimeSlots.end() &&
-              (spos == epos && spnt == 0 && epnt == 0))) {
-          if (spos != MergedTimeSlots.end() &&
-              spnt == 1) {  // right side of spos
-            bool update = false;
-
-            if (spos == epos) {
-              update = true;
-            }
-
-            // duration will be updated later
-            // Insert tmp after spos
-            auto tmp = MergedTimeSlots.insert(
-                ++spos,
-                TimeSlot(tsMEM.StartTick, tsMEM.EndTick - tsMEM.StartTick + 1));
-
-            if (update) {
-              epos = tmp;
-            }
-
-            spos = --tmp;  // update spos
-          }
-          else {
-            if (epos == MergedTimeSlots.end())  // both new
-            {
-              auto tmp =
-                  TimeSlot(tsMEM.StartTick,
-                           tsMEM.EndTick - tsMEM.StartTick + 1);  // copy one
-
-              MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
-            }
-            else {
-              auto tmp = TimeSlot(tsMEM.StartTick,
-                                  999);  // duration will be updated later
-              spos = MergedTimeSlots.insert(MergedTimeSlots.begin(), tmp);
-            }
-          }
-
-          if (epos != MergedTimeSlots.end()) {
-            if (epnt == 0) {
-              spos->EndTick = epos->EndTick;
-            }
-            else if (epnt == 1) {
-              spos->EndTick = tsMEM.EndTick;
-            }
-
-            // remove [ spos->Next ~ epos ]
-            auto iter = spos;
-
-            for (iter++; iter != epos;) {
-              iter = MergedTimeSlots.erase(iter);
-            }
+        ChFreeSlots[reqCh].InsertFreeSlot(latANTI * 2, DMA0tickFrom, tickDMA0,
+                                          ChStartPoint[reqCh], 1);
+      //******************************************************************//
 
-            // We need to erase epos
-            MergedTimeSlots.erase(epos);
-          }
-        }
-      }
-#endif  // END MERGE TIMESLOT
+      // Manage MergedTimeSlots
+      MergeTimeSlot(MergedTimeSlots, tsMEM);
     }
 
     // print Log
@@ -560,30 +422,14 @@ void PAL2::TimelineScheduling(Command &req, CPDPBP &reqCPD) {
     req.finished = tsDMA1.EndTick;
 
     // categorize the time spent for read/write operation
-    std::map<uint64_t, uint64_t>::iterator e;
-    e = OpTimeStamp[req.operation].find(tsDMA0.StartTick);
-    if (e != OpTimeStamp[req.operation].end()) {
-      if (e->second < tsDMA1.EndTick)
-        e->second = tsDMA1.EndTick;
-    }
-    else {
-      OpTimeStamp[req.operation][tsDMA0.StartTick] = tsDMA1.EndTick;
-    }
-    FlushOpTimeStamp();
+    stats->OpBusyTime[req.operation] += tsDMA1.EndTick - tsDMA0.StartTick + 1;
 
     // Update stats
-#if 1
-    stats->UpdateLastTick(tsDMA1.EndTick);
 #if GATHER_RESOURCE_CONFLICT
     stats->AddLatency(req, &reqCPD, reqDieIdx, tsDMA0, tsMEM, tsDMA1, confType);
 #else
     stats->AddLatency(req, &reqCPD, reqDieIdx, tsDMA0, tsMEM, tsDMA1);
 #endif
-#endif
-
-    if (req.operation == OPER_ERASE || req.mergeSnapshot) {
-      stats->MergeSnapshot();
-    }
   }
 }
 
@@ -591,275 +437,51 @@ void PAL2::submit(Command &cmd, CPDPBP &addr) {
   TimelineScheduling(cmd, addr);
 }
 
-void PAL2::FlushATimeSlotBusyTime(std::list<TimeSlot> &tgtTimeSlot,
-                                  uint64_t currentTick, uint64_t *TimeSum) {
-  auto cur = tgtTimeSlot.begin();
-
-  while (cur != tgtTimeSlot.end()) {
-    if (cur->EndTick < currentTick) {
-      *TimeSum += (cur->EndTick - cur->StartTick + 1);
+void PAL2::MergeTimeSlot(std::vector<TimeSlot> &tgtTimeSlot,
+                         TimeSlot &slot) {
+  // First slot which is not finished before new slot begins
+  auto begin = std::lower_bound(
+      tgtTimeSlot.begin(), tgtTimeSlot.end(), slot.StartTick,
+      [](const TimeSlot &a, uint64_t b) -> bool { return a.EndTick < b; });
+  auto end = begin;
 
-      cur = tgtTimeSlot.erase(cur);
-
-      continue;
-    }
-
-    break;
+  while (end != tgtTimeSlot.end() && end->StartTick <= slot.EndTick) {
+    end++;
   }
-}
 
-void PAL2::FlushOpTimeStamp()  // currently only used during garbage collection
-{
-  // flush OpTimeStamp
-  std::map<uint64_t, uint64_t>::iterator e;
-  for (unsigned Oper = 0; Oper < 3; Oper++) {
-    uint64_t start_tick = (uint64_t)-1, end_tick = (uint64_t)-1;
-    for (e = OpTimeStamp[Oper].begin(); e != OpTimeStamp[Oper].end();) {
-      if (start_tick == (uint64_t)-1 && end_tick == (uint64_t)-1) {
-        start_tick = e->first;
-        end_tick = e->second;
-      }
-      else if (e->first < end_tick && e->second <= end_tick) {
-      }
-      else if (e->first < end_tick && e->second > end_tick) {
-        end_tick = e->second;
-      }
-      else if (e->first >= end_tick) {
-        stats->OpBusyTime[Oper] += end_tick - start_tick + 1;
-        start_tick = e->first;
-        end_tick = e->second;
-      }
-      OpTimeStamp[Oper].erase(e);
-      e = OpTimeStamp[Oper].begin();
-    }
-    stats->OpBusyTime[Oper] += end_tick - start_tick + 1;
+  if (begin == end) {
+    tgtTimeSlot.insert(begin, slot);
   }
-}
-
-void PAL2::FlushTimeSlots(uint64_t currentTick) {
-  FlushATimeSlotBusyTime(MergedTimeSlots, currentTick, &(stats->ExactBusyTime));
-
-  stats->Access_Capacity.update();
-  stats->Ticks_Total.update();
-}
+  else {
+    begin->StartTick = MIN(begin->StartTick, slot.StartTick);
+    begin->EndTick = MAX((end - 1)->EndTick, slot.EndTick);
 
-void PAL2::FlushFreeSlots(uint64_t currentTick) {
-  for (uint32_t i = 0; i < pParam->channel; i++) {
-    FlushAFreeSlot(ChFreeSlots[i], currentTick);
+    tgtTimeSlot.erase(begin + 1, end);
   }
-  for (uint32_t i = 0; i < totalDie; i++) {
-    FlushAFreeSlot(DieFreeSlots[i], currentTick);
-  }
-
-  FlushATimeSlotBusyTime(MergedTimeSlots, currentTick, &(stats->ExactBusyTime));
-
-  stats->Access_Capacity.update();
-  stats->Ticks_Total.update();
-}
 
-void PAL2::FlushAFreeSlot(
-    std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-    uint64_t currentTick) {
-  for (std::map<uint64_t, std::map<uint64_t, uint64_t> *>::iterator e =
-           tgtFreeSlot.begin();
-       e != tgtFreeSlot.end(); e++) {
-    std::map<uint64_t, uint64_t>::iterator f = (e->second)->begin();
-    std::map<uint64_t, uint64_t>::iterator g = (e->second)->end();
-
-    for (; f != g;) {
-      // count++;
-      if (f->second < currentTick)
-        (e->second)->erase(f++);
-      else
-        break;
-    }
+  if (tgtTimeSlot.size() > TIMESLOT_CAPACITY) {
+    FlushATimeSlotBusyTime(tgtTimeSlot, tgtTimeSlot.front().EndTick + 1,
+                           &(stats->ExactBusyTime));
   }
 }
 
-std::list<TimeSlot>::iterator PAL2::FindFreeTime(
-    std::list<TimeSlot> &tgtTimeSlot, uint64_t tickLen, uint64_t fromTick) {
+void PAL2::FlushATimeSlotBusyTime(std::vector<TimeSlot> &tgtTimeSlot,
+                                  uint64_t currentTick, uint64_t *TimeSum) {
   auto cur = tgtTimeSlot.begin();
-  auto next = cur;
-
-  while (cur != tgtTimeSlot.end()) {
-    // printf("FindFreeTime.FIND : cur->ST=%llu, cur->ET=%llu, next=0x%X\n",
-    // cur->StartTick, cur->EndTick, (unsigned int)next); //DBG
-    next++;
-
-    if (next == tgtTimeSlot.end()) {
-      break;
-    }
 
-    if (cur->EndTick < fromTick && fromTick < next->StartTick) {
-      if ((next->StartTick - fromTick) >= tickLen) {
-        // printf("FindFreeTime.RET A: cur->ET=%llu, next->ST=%llu, ft=%llu,
-        // tickLen=%llu\n", cur->EndTick, next->StartTick, fromTick, tickLen);
-        // //DBG
-        break;
-      }
-    }
-    else if (fromTick <= cur->EndTick) {
-      if ((next->StartTick - (cur->EndTick + 1)) >= tickLen) {
-        break;
-      }
-    }
+  while (cur != tgtTimeSlot.end() && cur->EndTick < currentTick) {
+    *TimeSum += (cur->EndTick - cur->StartTick + 1);
 
     cur++;
   }
 
-  // v-- this condition looks strange? but [minus of uint64_t values] do not
-  // work correctly without this!
-  if ((tgtTimeSlot.begin()->StartTick > fromTick) &&
-      ((tgtTimeSlot.begin()->StartTick - fromTick) >= tickLen)) {
-    cur = tgtTimeSlot.end();  // if there is an available time slot before first
-                              // cmd, return NULL!
-  }
-
-  return cur;
+  tgtTimeSlot.erase(tgtTimeSlot.begin(), cur);
 }
 
-bool PAL2::FindFreeTime(
-    std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-    uint64_t tickLen, uint64_t tickFrom, uint64_t &startTick, bool &conflicts) {
-  auto e = tgtFreeSlot.upper_bound(tickLen);
-  if (e == tgtFreeSlot.end()) {
-    e--;  // Jie: tgtFreeSlot is not empty
-    auto f = (e->second)->upper_bound(tickFrom);
-    if (f != (e->second)->begin()) {
-      f--;
-      if (f->second >= tickLen + tickFrom - (uint64_t)1) {
-        startTick = f->first;
-        conflicts = false;
-        return true;
-      }
-      f++;
-    }
-    while (f != (e->second)->end()) {
-      if (f->second >= tickLen + f->first - 1) {
-        startTick = f->first;
-        conflicts = true;
-        return true;
-      }
-      f++;
-    }
-    // reach this means no FreeSlot satisfy the requirement; allocate unused
-    // slots  startTick will be updated in upper function
-    conflicts = false;
-    return false;
-  }
-  if (e != tgtFreeSlot.begin())
-    e--;
-  uint64_t minTick = (uint64_t)-1;
-  while (e != tgtFreeSlot.end()) {
-    std::map<uint64_t, uint64_t>::iterator f =
-        (e->second)->upper_bound(tickFrom);
-    if (f != (e->second)->begin()) {
-      f--;
-      if (f->second >=
-          tickLen + tickFrom - (uint64_t)1) {  // this free slot is
-                                               // best fit one, skip
-                                               // checking others
-        startTick = f->first;
-        conflicts = false;
-        return true;
-      }
-      f++;
-    }
-    while (f != (e->second)->end()) {
-      if (f->second >= tickLen + f->first - (uint64_t)1) {
-        if (minTick == (uint64_t)-1 || minTick > f->first) {
-          conflicts = true;
-          minTick = f->first;
-        }
-        break;
-      }
-      f++;
-    }
-    e++;
-  }
-  if (minTick == (uint64_t)-1) {
-    // startTick will be updated in upper function
-    conflicts = false;
-    return false;
-  }
-  else {
-    startTick = minTick;
-    return true;
-  }
-}
-
-void PAL2::InsertFreeSlot(
-    std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-    uint64_t tickLen, uint64_t tickFrom, uint64_t startTick,
-    uint64_t &startPoint, bool split) {
-  if (startTick == startPoint) {
-    if (tickFrom == startTick) {
-      if (split)
-        AddFreeSlot(tgtFreeSlot, tickLen, startPoint);
-      startPoint = startPoint + tickLen;  // Jie: just need to shift startPoint
-    }
-    else {
-      assert(tickFrom > startTick);
-      if (split)
-        AddFreeSlot(tgtFreeSlot, tickLen, tickFrom);
-      startPoint = tickFrom + tickLen;
-      AddFreeSlot(tgtFreeSlot, tickFrom - startTick, startTick);
-    }
-  }
-  else {
-    std::pair<std::map<uint64_t, std::map<uint64_t, uint64_t> *>::iterator,
-              std::map<uint64_t, std::map<uint64_t, uint64_t> *>::iterator>
-        ePair;
-    ePair = tgtFreeSlot.equal_range(tickLen);
-    std::map<uint64_t, uint64_t>::iterator f;
-    std::map<uint64_t, std::map<uint64_t, uint64_t> *>::iterator e =
-        tgtFreeSlot.upper_bound(tickLen);
-    if (e != tgtFreeSlot.begin())
-      e--;
-    while (e != tgtFreeSlot.end()) {
-      f = e->second->find(startTick);
-      if (f != e->second->end()) {
-        uint64_t tmpStartTick = f->first;
-        uint64_t tmpEndTick = f->second;
-        e->second->erase(f);
-        if (tmpStartTick < tickFrom) {
-          AddFreeSlot(tgtFreeSlot, tickFrom - tmpStartTick, tmpStartTick);
-          if (split)
-            AddFreeSlot(tgtFreeSlot, tickLen, tickFrom);
-          assert(tmpEndTick - tickFrom + 1 >= tickLen);
-          if (tmpEndTick > tickLen + tickFrom - (uint64_t)1) {
-            AddFreeSlot(tgtFreeSlot, tmpEndTick - (tickFrom + tickLen - 1),
-                        tickFrom + tickLen);
-          }
-        }
-        else {
-          assert(tmpStartTick == tickFrom);
-          assert(tmpEndTick - tickFrom + 1 >= tickLen);
-          if (split)
-            AddFreeSlot(tgtFreeSlot, tickLen, tmpStartTick);
-          if (tmpEndTick > tickLen + tickFrom - (uint64_t)1) {
-            AddFreeSlot(tgtFreeSlot, tmpEndTick - (tickFrom + tickLen - 1),
-                        tmpStartTick + tickLen);
-          }
-        }
-        break;
-      }
-      e++;
-    }
-  }
+void PAL2::FlushTimeSlots(uint64_t currentTick) {
+  FlushATimeSlotBusyTime(MergedTimeSlots, currentTick, &(stats->ExactBusyTime));
 }
 
-void PAL2::AddFreeSlot(
-    std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-    uint64_t tickLen, uint64_t tickFrom) {
-  std::map<uint64_t, std::map<uint64_t, uint64_t> *>::iterator e;
-  e = tgtFreeSlot.upper_bound(tickLen);
-  if (e != tgtFreeSlot.begin()) {
-    e--;
-    (e->second)->insert(std::pair<uint64_t, uint64_t>(
-        tickFrom, tickFrom + tickLen - (uint64_t)1));
-  }
-}
 // PPN number conversion
 uint32_t PAL2::CPDPBPtoDieIdx(CPDPBP *pCPDPBP) {
   //[Channel][Package][Die];
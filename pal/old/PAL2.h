@@ -50,48 +50,22 @@ class PAL2  // let's not inherit PAL1
   Latency *lat;
   PALStatistics *stats;  // statistics of PAL2, not created by itself
 
-  std::list<TimeSlot> MergedTimeSlots;  // for gathering busy time
+  std::vector<TimeSlot> MergedTimeSlots;  // for gathering busy time
 
   uint64_t totalDie;
 
-  std::map<uint64_t, uint64_t> OpTimeStamp[3];
-
-  std::map<uint64_t, std::map<uint64_t, uint64_t> *> *ChFreeSlots;
+  FreeSlotList *ChFreeSlots;
   uint64_t *ChStartPoint;  // record the start point of rightmost free slot
-  std::map<uint64_t, std::map<uint64_t, uint64_t> *> *DieFreeSlots;
+  FreeSlotList *DieFreeSlots;
   uint64_t *DieStartPoint;
 
   void submit(Command &cmd, CPDPBP &addr);
   void TimelineScheduling(Command &req, CPDPBP &reqCPD);
   void FlushTimeSlots(uint64_t currentTick);
-  void FlushOpTimeStamp();
-  void FlushATimeSlotBusyTime(std::list<TimeSlot> &tgtTimeSlot,
+  void MergeTimeSlot(std::vector<TimeSlot> &tgtTimeSlot, TimeSlot &slot);
+  void FlushATimeSlotBusyTime(std::vector<TimeSlot> &tgtTimeSlot,
                               uint64_t currentTick, uint64_t *TimeSum);
 
-  // you can insert a tickLen
-  // TimeSlot after Returned
-  // TimeSlot.
-  std::list<TimeSlot>::iterator FindFreeTime(std::list<TimeSlot> &tgtTimeSlot,
-                                             uint64_t tickLen,
-                                             uint64_t tickFrom);
-
-  // Jie: return: FreeSlot is found?
-  bool FindFreeTime(
-      std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-      uint64_t tickLen, uint64_t tickFrom, uint64_t &startTick,
-      bool &conflicts);
-  void InsertFreeSlot(
-      std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-      uint64_t tickLen, uint64_t tickFrom, uint64_t startTick,
-      uint64_t &startPoint, bool split);
-  void AddFreeSlot(
-      std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-      uint64_t tickLen, uint64_t tickFrom);
-  void FlushFreeSlots(uint64_t currentTick);
-  void FlushAFreeSlot(
-      std::map<uint64_t, std::map<uint64_t, uint64_t> *> &tgtFreeSlot,
-      uint64_t currentTick);
-
   // PPN Conversion related //ToDo: Shifted-Mode is also required for better
   // performance.
   uint32_t RearrangedSizes[7];
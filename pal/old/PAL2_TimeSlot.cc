@@ -19,7 +19,158 @@
 
 #include "PAL2_TimeSlot.h"
 
+#include <algorithm>
+#include <cassert>
+
 TimeSlot::TimeSlot(uint64_t startTick, uint64_t duration) {
   StartTick = startTick;
   EndTick = startTick + duration - 1;
 }
+
+FreeSlotList::FreeSlotList() : Head(0) {}
+
+// Largest class not longer than tickLen (0 when tickLen is below all classes)
+uint64_t FreeSlotList::GetClass(uint64_t tickLen) {
+  auto iter = std::upper_bound(SlotClass.begin(), SlotClass.end(), tickLen);
+
+  if (iter == SlotClass.begin()) {
+    return 0;
+  }
+
+  return *(--iter);
+}
+
+std::vector<TimeSlot>::iterator FreeSlotList::Begin() {
+  return Slots.begin() + Head;
+}
+
+// First slot starts after tick
+std::vector<TimeSlot>::iterator FreeSlotList::UpperBound(uint64_t tick) {
+  return std::upper_bound(
+      Begin(), Slots.end(), tick,
+      [](uint64_t a, const TimeSlot &b) -> bool { return a < b.StartTick; });
+}
+
+void FreeSlotList::AddClass(uint64_t tickLen) {
+  auto iter = std::lower_bound(SlotClass.begin(), SlotClass.end(), tickLen);
+
+  if (iter == SlotClass.end() || *iter != tickLen) {
+    SlotClass.insert(iter, tickLen);
+  }
+}
+
+bool FreeSlotList::FindFreeTime(uint64_t tickLen, uint64_t tickFrom,
+                                uint64_t &startTick, bool &conflicts) {
+  auto iter = UpperBound(tickFrom);
+
+  // Slot containing tickFrom is the best fit
+  if (iter != Begin()) {
+    auto prev = iter - 1;
+
+    if (prev->EndTick >= tickLen + tickFrom - (uint64_t)1) {
+      startTick = prev->StartTick;
+      conflicts = false;
+      return true;
+    }
+  }
+
+  // Otherwise, earliest slot after tickFrom which is long enough
+  for (; iter != Slots.end(); iter++) {
+    if (iter->EndTick >= tickLen + iter->StartTick - (uint64_t)1) {
+      startTick = iter->StartTick;
+      conflicts = true;
+      return true;
+    }
+  }
+
+  // startTick will be updated in upper function
+  conflicts = false;
+  return false;
+}
+
+void FreeSlotList::InsertFreeSlot(uint64_t tickLen, uint64_t tickFrom,
+                                  uint64_t startTick, uint64_t &startPoint,
+                                  bool split) {
+  if (startTick == startPoint) {
+    if (tickFrom == startTick) {
+      if (split)
+        AddFreeSlot(tickLen, startPoint);
+      startPoint = startPoint + tickLen;  // Jie: just need to shift startPoint
+    }
+    else {
+      assert(tickFrom > startTick);
+      if (split)
+        AddFreeSlot(tickLen, tickFrom);
+      startPoint = tickFrom + tickLen;
+      AddFreeSlot(tickFrom - startTick, startTick);
+    }
+  }
+  else {
+    auto iter = UpperBound(startTick);
+
+    if (iter == Begin()) {
+      return;
+    }
+
+    iter--;
+
+    // Old implementation only searched classes not shorter than tickLen
+    if (iter->StartTick != startTick ||
+        iter->EndTick - iter->StartTick + 1 < GetClass(tickLen)) {
+      return;
+    }
+
+    uint64_t tmpStartTick = iter->StartTick;
+    uint64_t tmpEndTick = iter->EndTick;
+
+    Slots.erase(iter);
+
+    if (tmpStartTick < tickFrom) {
+      AddFreeSlot(tickFrom - tmpStartTick, tmpStartTick);
+      if (split)
+        AddFreeSlot(tickLen, tickFrom);
+      assert(tmpEndTick - tickFrom + 1 >= tickLen);
+      if (tmpEndTick > tickLen + tickFrom - (uint64_t)1) {
+        AddFreeSlot(tmpEndTick - (tickFrom + tickLen - 1), tickFrom + tickLen);
+      }
+    }
+    else {
+      assert(tmpStartTick == tickFrom);
+      assert(tmpEndTick - tickFrom + 1 >= tickLen);
+      if (split)
+        AddFreeSlot(tickLen, tmpStartTick);
+      if (tmpEndTick > tickLen + tickFrom - (uint64_t)1) {
+        AddFreeSlot(tmpEndTick - (tickFrom + tickLen - 1),
+                    tmpStartTick + tickLen);
+      }
+    }
+  }
+}
+
+void FreeSlotList::AddFreeSlot(uint64_t tickLen, uint64_t tickFrom) {
+  if (SlotClass.size() > 0 && tickLen >= SlotClass.front()) {
+    Slots.insert(UpperBound(tickFrom), TimeSlot(tickFrom, tickLen));
+
+    // Drop oldest slot
+    if (Slots.size() - Head > TIMESLOT_CAPACITY) {
+      Head++;
+
+      Compact();
+    }
+  }
+}
+
+void FreeSlotList::FlushFreeSlots(uint64_t currentTick) {
+  while (Head < Slots.size() && Slots[Head].EndTick < currentTick) {
+    Head++;
+  }
+
+  Compact();
+}
+
+void FreeSlotList::Compact() {
+  if (Head * 2 >= Slots.size()) {
+    Slots.erase(Slots.begin(), Begin());
+    Head = 0;
+  }
+}
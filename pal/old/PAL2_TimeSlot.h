@@ -30,8 +30,15 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 using namespace std;
 
+// Slots which ended TIMESLOT_WINDOW before arrival of new request are dropped
+// and at most TIMESLOT_CAPACITY free slots are kept per resource, so memory
+// is bounded regardless of I/O rate without periodic flush.
+#define TIMESLOT_WINDOW 10000000000ull  // 0.01sec
+#define TIMESLOT_CAPACITY 16384
+
 struct TimeSlot {
   uint64_t StartTick;
   uint64_t EndTick;
@@ -40,4 +47,35 @@ struct TimeSlot {
   TimeSlot() : StartTick(0ull), EndTick(0ull){};
 };
 
+// Free time slots of one resource (channel or die)
+// Slots never overlap, so they are kept in one array sorted by StartTick.
+// Size classes are kept only to match the behavior of the old per-class
+// maps: slots shorter than the smallest class are not recorded.
+// Dropped slots are skipped by Head and compacted when they are the majority,
+// so dropping oldest slot is amortized O(1).
+class FreeSlotList {
+ private:
+  std::vector<uint64_t> SlotClass;
+  std::vector<TimeSlot> Slots;
+  size_t Head;  // First live slot in Slots
+
+  uint64_t GetClass(uint64_t tickLen);
+  std::vector<TimeSlot>::iterator Begin();
+  std::vector<TimeSlot>::iterator UpperBound(uint64_t tick);
+  void Compact();
+
+ public:
+  FreeSlotList();
+
+  void AddClass(uint64_t tickLen);
+
+  // Jie: return: FreeSlot is found?
+  bool FindFreeTime(uint64_t tickLen, uint64_t tickFrom, uint64_t &startTick,
+                    bool &conflicts);
+  void InsertFreeSlot(uint64_t tickLen, uint64_t tickFrom, uint64_t startTick,
+                      uint64_t &startPoint, bool split);
+  void AddFreeSlot(uint64_t tickLen, uint64_t tickFrom);
+  void FlushFreeSlots(uint64_t currentTick);
+};
+
 #endif
@@ -25,23 +25,15 @@
 #include "Latency.h"
 #include "PAL2_TimeSlot.h"
 
+#include "pal/config.hh"
 #include "sim/config_reader.hh"
-#include "sim/simulator.hh"
 
-#include <cassert>
-#include <cstdio>
-#include <cstdlib>
-#include <cstring>
-#include <exception>
-#include <fstream>
-#include <iostream>
-#include <limits>
-#include <map>
-#include <string>
+#include <cstdint>
+#include <vector>
 using namespace std;
 
-#define OPER_ALL (OPER_NUM + 1)
-#define PAGE_ALL (PAGE_NUM + 1)
+// Bucket i counts latency in [2^(i-1), 2^i) us, last bucket counts the rest
+#define LATENCY_HISTOGRAM_SIZE 16
 
 // From ftl_command.hh
 typedef struct _Command {
@@ -49,23 +41,23 @@ typedef struct _Command {
   Tick finished;
   Addr ppn;
   PAL_OPERATION operation;
-  bool mergeSnapshot;
   uint64_t size;
+  uint64_t retryLatency;  // Read-retry and ECC decode time added to MEM
 
   _Command()
       : arrived(0),
         finished(0),
         ppn(0),
         operation(OPER_NUM),
-        mergeSnapshot(false),
-        size(0) {}
+        size(0),
+        retryLatency(0) {}
   _Command(Tick t, Addr a, PAL_OPERATION op, uint64_t s)
       : arrived(t),
         finished(0),
         ppn(a),
         operation(op),
-        mergeSnapshot(false),
-        size(s) {}
+        size(s),
+        retryLatency(0) {}
 
   Tick getLatency() {
     if (finished > 0) {
@@ -77,114 +69,11 @@ typedef struct _Command {
   }
 } Command;
 
-// From ftl_defs.hh
-#define EPOCH_INTERVAL 100000000000
-
+// Statistics are gathered in tiers selected by StatLevel. Each tier only adds
+// plain counters, so AddLatency never allocates. Higher tier also gathers all
+// statistics of lower tiers.
 class PALStatistics {
  public:
-  enum {
-    /*
-    BUSY_DMA0WAIT = 0,
-    BUSY_DMA0 = 1,
-    BUSY_MEM  = 2,
-    BUSY_DMA1WAIT = 3,
-    BUSY_DMA1 = 4,
-    BUSY_END = 5
-    */
-    TICK_DMA0_CHANNEL_CONFLICT = TICK_NUM,
-    TICK_DMA0_PLANE_CONFLICT,
-    TICK_DMA1_CONFLICT,
-    TICK_DMA0_SUSPEND,
-    TICK_DMA1_SUSPEND,
-    TICK_PROC,
-    TICK_FULL,
-    TICK_STAT_NUM
-  };
-
-  SimpleSSD::ConfigReader *gconf;
-  Latency *lat;
-  uint64_t totalDie;
-
-#if 0  // ch-die io count (legacy)
-    class mini_cnt_page
-    {
-        public:
-        mini_cnt_page();
-        uint64_t c[OPER_NUM][PAGE_NUM];
-    };
-    mini_cnt_page* ch_io_cnt;
-    mini_cnt_page* die_io_cnt;
-#endif
-
-#if GATHER_RESOURCE_CONFLICT && 0  // conflict gather (legacy)
-  class mini_cnt_conflict {
-   public:
-    mini_cnt_conflict();
-    uint64_t c[OPER_NUM][CONFLICT_NUM];
-  };
-  mini_cnt_conflict *ch_conflict_cnt;
-  mini_cnt_conflict *ch_conflict_length;
-  mini_cnt_conflict *die_conflict_cnt;
-  mini_cnt_conflict *die_conflict_length;
-#endif
-
-#if 0  // latency (legacy method)
-    uint64_t latency_cnt[OPER_NUM][TICK_STAT_NUM]; // RWE count for: (page_size * cnt)/SIM_TIME
-    uint64_t latency_sum[OPER_NUM][TICK_STAT_NUM];
-#endif
-
-#if 0  // util time (legacy method)
-    uint64_t* channel_util_time_sum;
-    uint64_t* die_util_time_sum_mem;   //mem only-mem occupy
-    uint64_t* die_util_time_sum_optimum; //mem oper occupy optimum (DMA0+MEM+DMA1)
-    uint64_t* die_util_time_sum_all;  //mem oper actual occupy
-#endif
-
-#if 0  // stall
-    /*  StallInfo:
-           Actually, only use 5 entries --- 1a) TICK_DMA0_CHANNEL_CONFLICT, 1b) TICK_DMA0_PLANE_CONFLICT,
-                                            2) TICK_DMA1WAIT, 3) TICK_DMA0_SUSPEND, 4) TICK_DMA1_SUSPEND  */
-    uint64_t stall_sum[OPER_NUM][TICK_STAT_NUM];
-    uint64_t stall_cnt[OPER_NUM][TICK_STAT_NUM];
-    uint8_t LastDMA0Stall;
-    uint64_t LastDMA0AttemptTick;
-
-    void CountStall(uint8_t oper, uint8_t stall_kind);
-    void AddStall(uint8_t oper, uint8_t stall_kind, uint64_t lat);
-#endif
-
-  PALStatistics(SimpleSSD::ConfigReader *, Latency *);
-
-  ~PALStatistics();
-
-  /*
-  void AddLatency(uint32_t lat, uint8_t oper, uint8_t busyfor);
-  */
-
-  void AddLatency(Task *task);
-
-  /*
-  void AddOccupy(uint32_t ch, uint64_t ch_time, uint64_t pl, uint64_t pl_time,
-  uint64_t pl2_time);
-  */
-
-  uint64_t sim_start_time_ps;
-  uint64_t LastTick;
-  void UpdateLastTick(uint64_t tick);
-  uint64_t GetLastTick();
-#if GATHER_RESOURCE_CONFLICT
-  void AddLatency(Command &CMD, CPDPBP *CPD, uint32_t dieIdx, TimeSlot &DMA0,
-                  TimeSlot &MEM, TimeSlot &DMA1, uint8_t confType);
-#else
-  void AddLatency(Command &CMD, CPDPBP *CPD, uint32_t dieIdx, TimeSlot &DMA0,
-                  TimeSlot &MEM, TimeSlot &DMA1);
-#endif
-  void MergeSnapshot();
-  uint64_t ExactBusyTime, SampledExactBusyTime;
-  uint64_t OpBusyTime[3], LastOpBusyTime[3];  // 0: Read, 1: Write, 2: Erase;
-  uint64_t LastExactBusyTime;
-  uint64_t LastExecutionTime;
-
   struct Breakdown {
     double dma0wait;
     double dma0;
@@ -208,122 +97,75 @@ class PALStatistics {
     double min;
     double average;
     double max;
+    double total;
 
-    ActiveTime() : min(0.), average(0.), max(0.) {}
+    ActiveTime() : min(0.), average(0.), max(0.), total(0.) {}
   };
 
-  void PrintStats(uint64_t sim_time_ps);
+  PALStatistics(SimpleSSD::ConfigReader *, Latency *);
+  ~PALStatistics();
+
+#if GATHER_RESOURCE_CONFLICT
+  void AddLatency(Command &CMD, CPDPBP *CPD, uint32_t dieIdx, TimeSlot &DMA0,
+                  TimeSlot &MEM, TimeSlot &DMA1, uint8_t confType);
+#else
+  void AddLatency(Command &CMD, CPDPBP *CPD, uint32_t dieIdx, TimeSlot &DMA0,
+                  TimeSlot &MEM, TimeSlot &DMA1);
+#endif
   void ResetStats();
-  void PrintFinalStats(uint64_t sim_time_ps);
+
+  SimpleSSD::PAL::STAT_LEVEL getLevel();
 
   void getTickStat(OperStats &);        // Return busy ticks in ps
   void getEnergyStat(OperStats &);      // Return energy in uJ
   void getReadBreakdown(Breakdown &);   // Return READ breakdown in ps
   void getWriteBreakdown(Breakdown &);  // Return WRITE breakdown in ps
   void getEraseBreakdown(Breakdown &);  // Return ERASE breakdown in ps
+  void getLatencyHistogram(uint32_t, std::vector<double> &);
   void getChannelActiveTime(uint32_t, ActiveTime &);
   void getDieActiveTime(uint32_t, ActiveTime &);
   void getChannelActiveTimeAll(ActiveTime &);
   void getDieActiveTimeAll(ActiveTime &);
 
-  class Counter {
-   public:
-    Counter();
-    void init();
-    void add();
-    uint64_t cnt;
-  };
-
-  class CounterOper {
-   public:
-    CounterOper();
-    Counter cnts[OPER_ALL];
-    void init();
-    void add(uint32_t oper);
-    void printstat(const char *namestr);
-  };
+  uint64_t ExactBusyTime;
+  uint64_t OpBusyTime[3];  // 0: Read, 1: Write, 2: Erase;
 
-  CounterOper PPN_requested_rwe;
-  CounterOper PPN_requested_pagetype[PAGE_ALL];
-  CounterOper *PPN_requested_ch;   // channels
-  CounterOper *PPN_requested_die;  // dies
-  CounterOper CF_DMA0_dma;
-  CounterOper CF_DMA0_mem;
-  CounterOper CF_DMA0_none;
-  CounterOper CF_DMA1_dma;
-  CounterOper CF_DMA1_none;
+ private:
+  struct Value {
+    double sum;
+    double minval;
+    double maxval;
+    uint64_t cnt;
 
-  class Value {
-   public:
-    Value();
     void init();
     void add(double val);
-    void backup();
-    void update();
     double avg();
-    double legacy_avg();
-    double sum, minval, maxval, cnt, sampled_sum, sampled_cnt, legacy_sum,
-        legacy_cnt, legacy_minval, legacy_maxval;
   };
 
-  class ValueOper {
-   public:
-    ValueOper();
-    ValueOper(ValueOper *_ValueOper);
-    Value vals[OPER_ALL];
-    void init();
-    void update();
-    void add(uint32_t oper, double val);
-    void exclusive_add(uint32_t oper, double val);
-    void printstat(const char *namestr);
-    void printstat_bandwidth(class ValueOper *, uint64_t,
-                             uint64_t);  // bandwidth excluding idle time
-    void printstat_bandwidth_widle(class ValueOper *, uint64_t,
-                                   uint64_t);  // bandwidth including idle time
-    void printstat_oper_bandwidth(
-        class ValueOper *, uint64_t *,
-        uint64_t *);  // read/write/erase-only bandwidth
-    void printstat_latency(const char *namestr);
-    void printstat_iops(class ValueOper *, uint64_t, uint64_t);
-    void printstat_iops_widle(class ValueOper *, uint64_t, uint64_t);
-    void printstat_oper_iops(class ValueOper *, uint64_t *, uint64_t *);
-
-    void printstat_energy(const char *namestr);
+  struct OperValue {
+    uint64_t count;
+    double latency;  // Sum of D0W+D0+M+D1W+D1
+    double energy;   // Sum of energy in pJ
+
+    Value dma0wait;
+    Value dma0;
+    Value mem;
+    Value dma1wait;
+    Value dma1;
+    uint64_t histogram[LATENCY_HISTOGRAM_SIZE];
   };
 
-  ValueOper Ticks_DMA0WAIT;
-  ValueOper Ticks_DMA0;
-  ValueOper Ticks_MEM;
-  ValueOper Ticks_DMA1WAIT;
-  ValueOper Ticks_DMA1;
-  ValueOper Ticks_Total;  // Total = D0W+D0+M+D1W+D1
-                          // power
-  ValueOper Energy_DMA0;
-  ValueOper Energy_MEM;
-  ValueOper Energy_DMA1;
-  ValueOper Energy_Total;
-
-  std::map<uint64_t, ValueOper *> Ticks_Total_snapshot;
-  ValueOper Ticks_TotalOpti;    // TotalOpti = D0+M+D1 --- exclude WAIT
-  ValueOper *Ticks_Active_ch;   // channels
-  ValueOper *Ticks_Active_die;  // dies
-  ValueOper Access_Capacity;
-  std::map<uint64_t, ValueOper *> Access_Capacity_snapshot;
-  ValueOper Access_Bandwidth;
-  ValueOper Access_Bandwidth_widle;
-  ValueOper Access_Oper_Bandwidth;
-  ValueOper Access_Iops;
-  ValueOper Access_Iops_widle;
-  ValueOper Access_Oper_Iops;
-  uint64_t SampledTick;
-  bool skip;
+  SimpleSSD::PAL::STAT_LEVEL level;
+  Latency *lat;
+  uint32_t channel;
+  uint32_t totalDie;
 
-  void PrintDieIdleTicks(uint32_t die_num, uint64_t sim_time_ps,
-                         uint64_t idle_power_nw);
+  OperValue opers[OPER_NUM];
+  std::vector<Value> activeChannel;
+  std::vector<Value> activeDie;
 
- private:
-  void ClearStats();
-  void InitStats();
+  void getBreakdown(uint32_t, Breakdown &);
+  void getActiveTimeAll(std::vector<Value> &, ActiveTime &);
 };
 
 #endif  //__PALStatistics_h__
@@ -19,6 +19,7 @@
 
 #include "pal/pal.hh"
 
+#include "pal/event_pal.hh"
 #include "pal/pal_old.hh"
 
 namespace SimpleSSD {
@@ -110,7 +111,20 @@ PAL::PAL(ConfigReader &c) : conf(c) {
       param.channel * param.package * param.die * param.plane * param.block,
       param.superBlock);
 
-  pPAL = new PALOLD(param, c);
+  switch (conf.readInt(CONFIG_PAL, PAL_MODEL)) {
+    case OLD_MODEL:
+      pPAL = new PALOLD(param, c);
+
+      break;
+    case EVENT_MODEL:
+      pPAL = new EventPAL(param, c);
+
+      break;
+    default:
+      panic("Undefined PAL model");
+
+      break;
+  }
 }
 
 PAL::~PAL() {
@@ -129,6 +143,30 @@ void PAL::erase(Request &req, uint64_t &tick) {
   pPAL->erase(req, tick);
 }
 
+void PAL::read(Request &req, DMAFunction &func, void *context) {
+  pPAL->submit(req, OPER_READ, func, context);
+}
+
+void PAL::write(Request &req, DMAFunction &func, void *context) {
+  pPAL->submit(req, OPER_WRITE, func, context);
+}
+
+void PAL::erase(Request &req, DMAFunction &func, void *context) {
+  pPAL->submit(req, OPER_ERASE, func, context);
+}
+
+void PAL::read(std::vector<Request> &list, uint64_t &tick) {
+  pPAL->read(list, tick);
+}
+
+void PAL::write(std::vector<Request> &list, uint64_t &tick) {
+  pPAL->write(list, tick);
+}
+
+void PAL::erase(std::vector<Request> &list, uint64_t &tick) {
+  pPAL->erase(list, tick);
+}
+
 void PAL::copyback(uint32_t, uint32_t, uint32_t, uint64_t &) {
   panic("Copyback not implemented");
 }
@@ -20,6 +20,7 @@
 #ifndef __PAL_PAL__
 #define __PAL_PAL__
 
+#include "sim/dma_interface.hh"
 #include "util/def.hh"
 #include "util/simplessd.hh"
 
@@ -58,6 +59,16 @@ class PAL : public StatObject {
   void erase(Request &, uint64_t &);
   void copyback(uint32_t, uint32_t, uint32_t, uint64_t &);
 
+  void read(Request &, DMAFunction &, void * = nullptr);
+  void write(Request &, DMAFunction &, void * = nullptr);
+  void erase(Request &, DMAFunction &, void * = nullptr);
+
+  // All requests arrive at tick, old model issues them one by one
+  // Event-driven model issues them together to merge planes of a die
+  void read(std::vector<Request> &, uint64_t &);
+  void write(std::vector<Request> &, uint64_t &);
+  void erase(std::vector<Request> &, uint64_t &);
+
   Parameter *getInfo();
 
   void getStatList(std::vector<Stats> &, std::string) override;
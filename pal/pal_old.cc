@@ -22,16 +22,11 @@
 #include <sstream>
 
 #include "pal/old/Latency.h"
-#include "pal/old/LatencyMLC.h"
-#include "pal/old/LatencySLC.h"
-#include "pal/old/LatencyTLC.h"
 #include "pal/old/PAL2.h"
 #include "pal/old/PALStatistics.h"
+#include "pal/read_retry.hh"
 #include "util/algorithm.hh"
 
-#define FLUSH_PERIOD 100000000000ull  // 0.1sec
-#define FLUSH_RANGE 10000000000ull    // 0.01sec
-
 namespace SimpleSSD {
 
 namespace PAL {
@@ -39,20 +34,16 @@ namespace PAL {
 PALOLD::PALOLD(Parameter &p, ConfigReader &c)
     : AbstractPAL(p, c), lastResetTick(0) {
   Config::NANDTiming *pTiming = c.getNANDTiming();
-  Config::NANDPower *pPower = c.getNANDPower();
 
   memset(&stat, 0, sizeof(stat));
 
-  switch (conf.readInt(CONFIG_PAL, NAND_FLASH_TYPE)) {
-    case NAND_SLC:
-      lat = new LatencySLC(*pTiming, *pPower);
-      break;
-    case NAND_MLC:
-      lat = new LatencyMLC(*pTiming, *pPower);
-      break;
-    case NAND_TLC:
-      lat = new LatencyTLC(*pTiming, *pPower);
-      break;
+  lat = createLatency();
+
+  if (conf.readBoolean(CONFIG_PAL, PAL_USE_READ_RETRY)) {
+    readRetry = new ReadRetry(param, conf);
+  }
+  else {
+    readRetry = nullptr;
   }
 
   if (conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP)) {
@@ -82,36 +73,31 @@ PALOLD::PALOLD(Parameter &p, ConfigReader &c)
 
   stats = new PALStatistics(&conf, lat);
   pal = new PAL2(stats, &param, &conf, lat);
-
-  // We will periodically flush timeslot for saving memory
-  flushFunction = [this](uint64_t tick) {
-    pal->FlushFreeSlots(tick - FLUSH_RANGE);
-    pal->FlushTimeSlots(tick - FLUSH_RANGE);
-
-    schedule(flushEvent, tick + FLUSH_PERIOD);
-  };
-  flushEvent = allocate(flushFunction);
-  schedule(flushEvent, getTick() + FLUSH_PERIOD);
 }
 
 PALOLD::~PALOLD() {
   delete pal;
   delete stats;
   delete lat;
+  delete readRetry;
 }
 
 void PALOLD::read(Request &req, uint64_t &tick) {
   uint64_t finishedAt = tick;
   ::Command cmd(tick, 0, OPER_READ, param.superPageSize);
-  std::vector<::CPDPBP> list;
 
   printPPN(req, "READ");
 
-  convertCPDPBP(req, list);
+  convertCPDPBP(req, addressList);
 
-  for (auto &iter : list) {
+  for (auto &iter : addressList) {
     printCPDPBP(iter, "READ");
 
+    if (readRetry) {
+      cmd.retryLatency = readRetry->read(
+          iter, tick, lat->GetLatency(iter.Page, OPER_READ, BUSY_MEM));
+    }
+
     pal->submit(cmd, iter);
     stat.readCount++;
 
@@ -124,15 +110,18 @@ void PALOLD::read(Request &req, uint64_t &tick) {
 void PALOLD::write(Request &req, uint64_t &tick) {
   uint64_t finishedAt = tick;
   ::Command cmd(tick, 0, OPER_WRITE, param.superPageSize);
-  std::vector<::CPDPBP> list;
 
   printPPN(req, "WRITE");
 
-  convertCPDPBP(req, list);
+  convertCPDPBP(req, addressList);
 
-  for (auto &iter : list) {
+  for (auto &iter : addressList) {
     printCPDPBP(iter, "WRITE");
 
+    if (readRetry) {
+      readRetry->program(iter, tick);
+    }
+
     pal->submit(cmd, iter);
     stat.writeCount++;
 
@@ -145,15 +134,18 @@ void PALOLD::write(Request &req, uint64_t &tick) {
 void PALOLD::erase(Request &req, uint64_t &tick) {
   uint64_t finishedAt = tick;
   ::Command cmd(tick, 0, OPER_ERASE, param.superPageSize * param.page);
-  std::vector<::CPDPBP> list;
 
   printPPN(req, "ERASE");
 
-  convertCPDPBP(req, list);
+  convertCPDPBP(req, addressList);
 
-  for (auto &iter : list) {
+  for (auto &iter : addressList) {
     printCPDPBP(iter, "ERASE");
 
+    if (readRetry) {
+      readRetry->erase(iter);
+    }
+
     pal->submit(cmd, iter);
     stat.eraseCount++;
 
@@ -163,167 +155,6 @@ void PALOLD::erase(Request &req, uint64_t &tick) {
   tick = finishedAt;
 }
 
-void PALOLD::convertCPDPBP(Request &req, std::vector<::CPDPBP> &list) {
-  ::CPDPBP addr;
-  static uint32_t pageAllocation = conf.getPageAllocationConfig();
-  static uint8_t superblock = conf.getSuperblockConfig();
-  static bool useMultiplaneOP =
-      conf.readBoolean(CONFIG_PAL, NAND_USE_MULTI_PLANE_OP);
-  static uint32_t pageInSuperPage = param.pageInSuperPage;
-  static bool bRandomTweak =
-      conf.readBoolean(CONFIG_FTL, FTL::FTL_USE_RANDOM_IO_TWEAK);
-  uint32_t value[4];
-  uint32_t *ptr[4];
-  uint64_t tmp = req.blockIndex;
-  int count = 0;
-
-  if (bRandomTweak && req.ioFlag.size() != pageInSuperPage) {
-    panic("Invalid size of I/O flag");
-  }
-
-  if (!bRandomTweak && req.ioFlag.size() != pageInSuperPage) {
-    req.ioFlag = Bitset(pageInSuperPage);
-    req.ioFlag.set();
-  }
-
-  list.clear();
-
-  addr.Plane = 0;
-
-  for (int i = 0; i < 4; i++) {
-    uint8_t idx = (pageAllocation >> (i * 8)) & 0xFF;
-
-    switch (idx) {
-      case INDEX_CHANNEL:
-        if (superblock & INDEX_CHANNEL) {
-          value[count] = param.channel;
-          ptr[count++] = &addr.Channel;
-        }
-        else {
-          addr.Channel = tmp % param.channel;
-          tmp /= param.channel;
-        }
-
-        break;
-      case INDEX_PACKAGE:
-        if (superblock & INDEX_PACKAGE) {
-          value[count] = param.package;
-          ptr[count++] = &addr.Package;
-        }
-        else {
-          addr.Package = tmp % param.package;
-          tmp /= param.package;
-        }
-
-        break;
-      case INDEX_DIE:
-        if (superblock & INDEX_DIE) {
-          value[count] = param.die;
-          ptr[count++] = &addr.Die;
-        }
-        else {
-          addr.Die = tmp % param.die;
-          tmp /= param.die;
-        }
-
-        break;
-      case INDEX_PLANE:
-        if (!useMultiplaneOP) {
-          if (superblock & INDEX_PLANE) {
-            value[count] = param.plane;
-            ptr[count++] = &addr.Plane;
-          }
-          else {
-            addr.Plane = tmp % param.plane;
-            tmp /= param.plane;
-          }
-        }
-
-        break;
-      default:
-        break;
-    }
-  }
-
-  addr.Block = tmp;
-  addr.Page = req.pageIndex;
-
-  // Index of ioFlag
-  tmp = 0;
-
-  if (count == 4) {
-    list.reserve(value[0] * value[1] * value[2] * value[3]);
-
-    for (uint32_t i = 0; i < value[3]; i++) {
-      for (uint32_t j = 0; j < value[2]; j++) {
-        for (uint32_t k = 0; k < value[1]; k++) {
-          for (uint32_t l = 0; l < value[0]; l++) {
-            if (req.ioFlag.test(tmp++)) {
-              *ptr[0] = l;
-              *ptr[1] = k;
-              *ptr[2] = j;
-              *ptr[3] = i;
-
-              list.push_back(addr);
-            }
-          }
-        }
-      }
-    }
-  }
-  else if (count == 3) {
-    list.reserve(value[0] * value[1] * value[2]);
-
-    for (uint32_t j = 0; j < value[2]; j++) {
-      for (uint32_t k = 0; k < value[1]; k++) {
-        for (uint32_t l = 0; l < value[0]; l++) {
-          if (req.ioFlag.test(tmp++)) {
-            *ptr[0] = l;
-            *ptr[1] = k;
-            *ptr[2] = j;
-
-            list.push_back(addr);
-          }
-        }
-      }
-    }
-  }
-  else if (count == 2) {
-    list.reserve(value[0] * value[1]);
-
-    for (uint32_t k = 0; k < value[1]; k++) {
-      for (uint32_t l = 0; l < value[0]; l++) {
-        if (req.ioFlag.test(tmp++)) {
-          *ptr[0] = l;
-          *ptr[1] = k;
-
-          list.push_back(addr);
-        }
-      }
-    }
-  }
-  else if (count == 1) {
-    list.reserve(value[0]);
-
-    for (uint32_t l = 0; l < value[0]; l++) {
-      if (req.ioFlag.test(tmp++)) {
-        *ptr[0] = l;
-
-        list.push_back(addr);
-      }
-    }
-  }
-  else {
-    if (req.ioFlag.test(tmp++)) {
-      list.push_back(addr);
-    }
-  }
-
-  if (tmp != pageInSuperPage) {
-    panic("I/O flag size != # pages in super page");
-  }
-}
-
 void PALOLD::printCPDPBP(::CPDPBP &addr, const char *prefix) {
   debugprint(LOG_PAL_OLD,
              "%-5s | C %5u | W %5u | D %5u | P %5u | B %5u | P %5u", prefix,
@@ -383,85 +214,138 @@ void PALOLD::getStatList(std::vector<Stats> &list, std::string prefix) {
   temp.desc = "Total erase operation bytes";
   list.push_back(temp);
 
-  temp.name = prefix + "read.time.dma0.wait";
-  temp.desc = "Average dma0 wait time of read";
-  list.push_back(temp);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    temp.name = prefix + "read.time.dma0.wait";
+    temp.desc = "Average dma0 wait time of read";
+    list.push_back(temp);
 
-  temp.name = prefix + "read.time.dma0";
-  temp.desc = "Average dma0 time of read";
-  list.push_back(temp);
+    temp.name = prefix + "read.time.dma0";
+    temp.desc = "Average dma0 time of read";
+    list.push_back(temp);
 
-  temp.name = prefix + "read.time.mem";
-  temp.desc = "Average memory operation time of read";
-  list.push_back(temp);
+    temp.name = prefix + "read.time.mem";
+    temp.desc = "Average memory operation time of read";
+    list.push_back(temp);
 
-  temp.name = prefix + "read.time.dma1.wait";
-  temp.desc = "Average dma1 wait time of read";
-  list.push_back(temp);
+    temp.name = prefix + "read.time.dma1.wait";
+    temp.desc = "Average dma1 wait time of read";
+    list.push_back(temp);
 
-  temp.name = prefix + "read.time.dma1";
-  temp.desc = "Average dma1 time of read";
-  list.push_back(temp);
+    temp.name = prefix + "read.time.dma1";
+    temp.desc = "Average dma1 time of read";
+    list.push_back(temp);
+  }
 
   temp.name = prefix + "read.time.total";
   temp.desc = "Average time of read";
   list.push_back(temp);
 
-  temp.name = prefix + "program.time.dma0.wait";
-  temp.desc = "Average dma0 wait time of program";
-  list.push_back(temp);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    temp.name = prefix + "program.time.dma0.wait";
+    temp.desc = "Average dma0 wait time of program";
+    list.push_back(temp);
 
-  temp.name = prefix + "program.time.dma0";
-  temp.desc = "Average dma0 time of program";
-  list.push_back(temp);
+    temp.name = prefix + "program.time.dma0";
+    temp.desc = "Average dma0 time of program";
+    list.push_back(temp);
 
-  temp.name = prefix + "program.time.mem";
-  temp.desc = "Average memory operation time of program";
-  list.push_back(temp);
+    temp.name = prefix + "program.time.mem";
+    temp.desc = "Average memory operation time of program";
+    list.push_back(temp);
 
-  temp.name = prefix + "program.time.dma1.wait";
-  temp.desc = "Average dma1 wait time of program";
-  list.push_back(temp);
+    temp.name = prefix + "program.time.dma1.wait";
+    temp.desc = "Average dma1 wait time of program";
+    list.push_back(temp);
 
-  temp.name = prefix + "program.time.dma1";
-  temp.desc = "Average dma1 time of program";
-  list.push_back(temp);
+    temp.name = prefix + "program.time.dma1";
+    temp.desc = "Average dma1 time of program";
+    list.push_back(temp);
+  }
 
   temp.name = prefix + "program.time.total";
   temp.desc = "Average time of program";
   list.push_back(temp);
 
-  temp.name = prefix + "erase.time.dma0.wait";
-  temp.desc = "Average dma0 wait time of erase";
-  list.push_back(temp);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    temp.name = prefix + "erase.time.dma0.wait";
+    temp.desc = "Average dma0 wait time of erase";
+    list.push_back(temp);
 
-  temp.name = prefix + "erase.time.dma0";
-  temp.desc = "Average dma0 time of erase";
-  list.push_back(temp);
+    temp.name = prefix + "erase.time.dma0";
+    temp.desc = "Average dma0 time of erase";
+    list.push_back(temp);
 
-  temp.name = prefix + "erase.time.mem";
-  temp.desc = "Average memory operation time of erase";
-  list.push_back(temp);
+    temp.name = prefix + "erase.time.mem";
+    temp.desc = "Average memory operation time of erase";
+    list.push_back(temp);
 
-  temp.name = prefix + "erase.time.dma1.wait";
-  temp.desc = "Average dma1 wait time of erase";
-  list.push_back(temp);
+    temp.name = prefix + "erase.time.dma1.wait";
+    temp.desc = "Average dma1 wait time of erase";
+    list.push_back(temp);
 
-  temp.name = prefix + "erase.time.dma1";
-  temp.desc = "Average dma1 time of erase";
-  list.push_back(temp);
+    temp.name = prefix + "erase.time.dma1";
+    temp.desc = "Average dma1 time of erase";
+    list.push_back(temp);
+  }
 
   temp.name = prefix + "erase.time.total";
   temp.desc = "Average time of erase";
   list.push_back(temp);
 
-  temp.name = prefix + "channel.time.active";
-  temp.desc = "Average active time of all channels";
-  list.push_back(temp);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    const char *opers[] = {"read", "program", "erase"};
 
-  temp.name = prefix + "die.time.active";
-  temp.desc = "Average active time of all dies";
-  list.push_back(temp);
+    for (auto oper : opers) {
+      for (uint32_t i = 0; i < LATENCY_HISTOGRAM_SIZE; i++) {
+        std::string number = std::to_string(i);
+
+        temp.name = prefix + oper + ".time.hist" + number;
+
+        if (i == 0) {
+          temp.desc = std::string("Total ") + oper +
+                      " count with latency under 1us";
+        }
+        else if (i + 1 < LATENCY_HISTOGRAM_SIZE) {
+          temp.desc = std::string("Total ") + oper + " count with latency " +
+                      std::to_string(1 << (i - 1)) + "us to " +
+                      std::to_string(1 << i) + "us";
+        }
+        else {
+          temp.desc = std::string("Total ") + oper + " count with latency " +
+                      std::to_string(1 << (i - 1)) + "us or more";
+        }
+
+        list.push_back(temp);
+      }
+    }
+  }
+
+  if (stats->getLevel() >= STAT_UTILIZATION) {
+    temp.name = prefix + "channel.time.active";
+    temp.desc = "Average active time of all channels";
+    list.push_back(temp);
+
+    temp.name = prefix + "die.time.active";
+    temp.desc = "Average active time of all dies";
+    list.push_back(temp);
+
+    for (uint32_t i = 0; i < param.channel; i++) {
+      temp.name = prefix + "channel" + std::to_string(i) + ".time.busy";
+      temp.desc = "Total active time of channel " + std::to_string(i);
+      list.push_back(temp);
+    }
+
+    for (uint32_t i = 0; i < param.channel * param.package * param.die;
+         i++) {
+      temp.name = prefix + "die" + std::to_string(i) + ".time.busy";
+      temp.desc = "Total active time of die " + std::to_string(i);
+      list.push_back(temp);
+    }
+  }
+
+  if (readRetry) {
+    readRetry->getStatList(list, prefix);
+  }
 }
 
 void PALOLD::getStatValues(std::vector<double> &values) {
@@ -492,35 +376,67 @@ void PALOLD::getStatValues(std::vector<double> &values) {
   values.push_back(stat.eraseCount * param.pageSize * param.page *
                    planeMultiplier);
 
-  stats->getReadBreakdown(breakdown);
-  values.push_back(breakdown.dma0wait);
-  values.push_back(breakdown.dma0);
-  values.push_back(breakdown.mem);
-  values.push_back(breakdown.dma1wait);
-  values.push_back(breakdown.dma1);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    stats->getReadBreakdown(breakdown);
+    values.push_back(breakdown.dma0wait);
+    values.push_back(breakdown.dma0);
+    values.push_back(breakdown.mem);
+    values.push_back(breakdown.dma1wait);
+    values.push_back(breakdown.dma1);
+  }
+
   values.push_back(ticks.read);
 
-  stats->getWriteBreakdown(breakdown);
-  values.push_back(breakdown.dma0wait);
-  values.push_back(breakdown.dma0);
-  values.push_back(breakdown.mem);
-  values.push_back(breakdown.dma1wait);
-  values.push_back(breakdown.dma1);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    stats->getWriteBreakdown(breakdown);
+    values.push_back(breakdown.dma0wait);
+    values.push_back(breakdown.dma0);
+    values.push_back(breakdown.mem);
+    values.push_back(breakdown.dma1wait);
+    values.push_back(breakdown.dma1);
+  }
+
   values.push_back(ticks.write);
 
-  stats->getEraseBreakdown(breakdown);
-  values.push_back(breakdown.dma0wait);
-  values.push_back(breakdown.dma0);
-  values.push_back(breakdown.mem);
-  values.push_back(breakdown.dma1wait);
-  values.push_back(breakdown.dma1);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    stats->getEraseBreakdown(breakdown);
+    values.push_back(breakdown.dma0wait);
+    values.push_back(breakdown.dma0);
+    values.push_back(breakdown.mem);
+    values.push_back(breakdown.dma1wait);
+    values.push_back(breakdown.dma1);
+  }
+
   values.push_back(ticks.erase);
 
-  stats->getChannelActiveTimeAll(active);
-  values.push_back(active.average);
+  if (stats->getLevel() >= STAT_LATENCY) {
+    stats->getLatencyHistogram(OPER_READ, values);
+    stats->getLatencyHistogram(OPER_WRITE, values);
+    stats->getLatencyHistogram(OPER_ERASE, values);
+  }
+
+  if (stats->getLevel() >= STAT_UTILIZATION) {
+    stats->getChannelActiveTimeAll(active);
+    values.push_back(active.average);
+
+    stats->getDieActiveTimeAll(active);
+    values.push_back(active.average);
+
+    for (uint32_t i = 0; i < param.channel; i++) {
+      stats->getChannelActiveTime(i, active);
+      values.push_back(active.total);
+    }
+
+    for (uint32_t i = 0; i < param.channel * param.package * param.die;
+         i++) {
+      stats->getDieActiveTime(i, active);
+      values.push_back(active.total);
+    }
+  }
 
-  stats->getDieActiveTimeAll(active);
-  values.push_back(active.average);
+  if (readRetry) {
+    readRetry->getStatValues(values);
+  }
 }
 
 void PALOLD::resetStatValues() {
@@ -528,12 +444,22 @@ void PALOLD::resetStatValues() {
   lastResetTick = getTick();
 
   memset(&stat, 0, sizeof(stat));
+
+  if (readRetry) {
+    readRetry->resetStatValues();
+  }
 }
 
 void PALOLD::read(::CPDPBP &addr, uint64_t &tick) {
   ::Command cmd(tick, 0, OPER_READ, param.superPageSize);
 
   printCPDPBP(addr, "READ");
+
+  if (readRetry) {
+    cmd.retryLatency = readRetry->read(
+        addr, tick, lat->GetLatency(addr.Page, OPER_READ, BUSY_MEM));
+  }
+
   pal->submit(cmd, addr);
   stat.readCount++;
 
@@ -544,6 +470,11 @@ void PALOLD::write(::CPDPBP &addr, uint64_t &tick) {
   ::Command cmd(tick, 0, OPER_WRITE, param.superPageSize);
 
   printCPDPBP(addr, "WRITE");
+
+  if (readRetry) {
+    readRetry->program(addr, tick);
+  }
+
   pal->submit(cmd, addr);
   stat.writeCount++;
 
@@ -554,6 +485,11 @@ void PALOLD::erase(::CPDPBP &addr, uint64_t &tick) {
   ::Command cmd(tick, 0, OPER_ERASE, param.superPageSize * param.page);
 
   printCPDPBP(addr, "ERASE");
+
+  if (readRetry) {
+    readRetry->erase(addr);
+  }
+
   pal->submit(cmd, addr);
   stat.eraseCount++;
 
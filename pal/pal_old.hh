@@ -34,14 +34,14 @@ namespace SimpleSSD {
 
 namespace PAL {
 
+class ReadRetry;
+
 class PALOLD : public AbstractPAL {
  private:
   ::PAL2 *pal;
   ::PALStatistics *stats;
   ::Latency *lat;
-
-  Event flushEvent;
-  EventFunction flushFunction;
+  ReadRetry *readRetry;
 
   uint64_t lastResetTick;
   uint64_t planeMultiplier;
@@ -52,7 +52,6 @@ class PALOLD : public AbstractPAL {
     uint64_t eraseCount;
   } stat;
 
-  void convertCPDPBP(Request &, std::vector<::CPDPBP> &);
   void printCPDPBP(::CPDPBP &, const char *);
   void printPPN(Request &, const char *);
 
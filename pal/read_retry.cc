@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pal/read_retry.hh"
+
+#include <cmath>
+
+#define TICK_PER_HOUR 3600000000000000ull  // 3600sec
+
+namespace SimpleSSD {
+
+namespace PAL {
+
+ReadRetry::ReadRetry(Parameter &p, ConfigReader &c) : param(p) {
+  BlockState init;
+
+  rberBase = c.readFloat(CONFIG_PAL, PAL_RBER_BASE);
+  rberWear = c.readFloat(CONFIG_PAL, PAL_RBER_WEAR);
+  rberRetention = c.readFloat(CONFIG_PAL, PAL_RBER_RETENTION);
+  rberDisturb = c.readFloat(CONFIG_PAL, PAL_RBER_DISTURB);
+  correctableRBER = c.readFloat(CONFIG_PAL, PAL_CORRECTABLE_RBER);
+  retryGain = c.readFloat(CONFIG_PAL, PAL_RETRY_GAIN);
+  maxRetry = c.readUint(CONFIG_PAL, PAL_MAX_READ_RETRY);
+  decodeLatency = c.readUint(CONFIG_PAL, PAL_DECODE_LATENCY);
+  softDecodeLatency = c.readUint(CONFIG_PAL, PAL_SOFT_DECODE_LATENCY);
+  initialRetention =
+      c.readUint(CONFIG_PAL, PAL_INITIAL_RETENTION) * TICK_PER_HOUR;
+
+  // All blocks hold data written before simulation
+  init.eraseCount = c.readUint(CONFIG_PAL, PAL_INITIAL_PE_CYCLE);
+  init.readCount = 0;
+  init.programmedAt = 0;
+  init.programmed = true;
+  init.initial = true;
+
+  blocks.resize((uint64_t)param.channel * param.package * param.die *
+                    param.plane * param.block,
+                init);
+
+  stat.distribution.resize(maxRetry + 1);
+  resetStatValues();
+}
+
+ReadRetry::~ReadRetry() {}
+
+uint32_t ReadRetry::getBlockIndex(::CPDPBP &addr) {
+  uint32_t die =
+      (addr.Channel * param.package + addr.Package) * param.die + addr.Die;
+
+  return (die * param.plane + addr.Plane) * param.block + addr.Block;
+}
+
+// Returns additional latency of read caused by read-retry and ECC decoding
+uint64_t ReadRetry::read(::CPDPBP &addr, uint64_t tick, uint64_t pageRead) {
+  BlockState &block = blocks[getBlockIndex(addr)];
+  double kPE = block.eraseCount / 1000.;
+  double hours = 0.;
+  double rber;
+  uint32_t steps = 0;
+  bool soft = false;
+
+  if (block.programmed) {
+    if (tick > block.programmedAt) {
+      hours = (double)(tick - block.programmedAt) / TICK_PER_HOUR;
+    }
+
+    if (block.initial) {
+      hours += (double)initialRetention / TICK_PER_HOUR;
+    }
+  }
+
+  rber = rberBase + rberWear * kPE * kPE +
+         rberRetention * (1. + kPE) * hours +
+         rberDisturb * block.readCount / 1000.;
+
+  block.readCount++;
+
+  if (rber > correctableRBER) {
+    steps = (uint32_t)ceil(log(rber / correctableRBER) / log(1. / retryGain));
+
+    if (steps > maxRetry) {
+      steps = maxRetry;
+      soft = true;
+    }
+  }
+
+  stat.count++;
+  stat.rber += rber;
+
+  if (soft) {
+    stat.soft++;
+  }
+  else {
+    stat.distribution[steps]++;
+  }
+
+  if (steps > 0) {
+    stat.retried++;
+    stat.steps += steps;
+  }
+
+  return steps * (pageRead + decodeLatency) + (soft ? softDecodeLatency : 0);
+}
+
+void ReadRetry::program(::CPDPBP &addr, uint64_t tick) {
+  BlockState &block = blocks[getBlockIndex(addr)];
+
+  if (!block.programmed) {
+    block.programmedAt = tick;
+    block.programmed = true;
+  }
+}
+
+void ReadRetry::erase(::CPDPBP &addr) {
+  BlockState &block = blocks[getBlockIndex(addr)];
+
+  block.eraseCount++;
+  block.readCount = 0;
+  block.programmed = false;
+  block.initial = false;
+}
+
+void ReadRetry::getStatList(std::vector<Stats> &list, std::string prefix) {
+  Stats temp;
+
+  temp.name = prefix + "retry.count";
+  temp.desc = "Total read count which required read-retry";
+  list.push_back(temp);
+
+  temp.name = prefix + "retry.steps";
+  temp.desc = "Total read-retry steps";
+  list.push_back(temp);
+
+  temp.name = prefix + "retry.soft";
+  temp.desc = "Total read count which required soft decoding";
+  list.push_back(temp);
+
+  temp.name = prefix + "retry.rber";
+  temp.desc = "Average raw bit error rate of read";
+  list.push_back(temp);
+
+  for (uint32_t i = 0; i <= maxRetry; i++) {
+    std::string number = std::to_string(i);
+
+    temp.name = prefix + "retry.step" + number;
+    temp.desc = "Total read count decoded after " + number + " retry steps";
+    list.push_back(temp);
+  }
+}
+
+void ReadRetry::getStatValues(std::vector<double> &values) {
+  values.push_back(stat.retried);
+  values.push_back(stat.steps);
+  values.push_back(stat.soft);
+  values.push_back(stat.count > 0 ? stat.rber / stat.count : 0.);
+
+  for (auto &iter : stat.distribution) {
+    values.push_back(iter);
+  }
+}
+
+void ReadRetry::resetStatValues() {
+  stat.count = 0;
+  stat.retried = 0;
+  stat.steps = 0;
+  stat.soft = 0;
+  stat.rber = 0.;
+
+  for (auto &iter : stat.distribution) {
+    iter = 0;
+  }
+}
+
+}  // namespace PAL
+
+}  // namespace SimpleSSD
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2017 CAMELab
+ *
+ * This file is part of SimpleSSD.
+ *
+ * SimpleSSD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SimpleSSD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SimpleSSD.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PAL_READ_RETRY__
+#define __PAL_READ_RETRY__
+
+#include <cinttypes>
+#include <vector>
+
+#include "pal/pal.hh"
+#include "util/old/SimpleSSD_types.h"
+
+namespace SimpleSSD {
+
+namespace PAL {
+
+/**
+ * \brief Read-retry and ECC decode latency model
+ *
+ * Raw bit error rate (RBER) of page is estimated from P/E cycle, retention
+ * time and read disturb count of physical block:
+ *   RBER = Base + Wear * kPE^2 + Retention * (1 + kPE) * hours
+ *          + Disturb * kReads
+ * where kPE is P/E cycle / 1000 and kReads is # reads after last erase / 1000.
+ *
+ * When RBER exceeds correction capability of hard decision decoding, each
+ * read-retry step (re-sense page with shifted read reference voltage, then
+ * decode again) reduces RBER by RetryGain. If MaxReadRetry steps are not
+ * enough, soft decision decoding is used.
+ *
+ * Every erase goes through PAL, so P/E cycle of block tracked here is same as
+ * FTL::Block::getEraseCount, plus InitialPECycle.
+ */
+class ReadRetry : public StatObject {
+ private:
+  struct BlockState {
+    uint32_t eraseCount;
+    uint32_t readCount;     //!< # reads after last erase
+    uint64_t programmedAt;  //!< First program after last erase
+    bool programmed;        //!< Block holds data
+    bool initial;           //!< Data is written before simulation
+  };
+
+  Parameter &param;
+
+  std::vector<BlockState> blocks;
+
+  double rberBase;
+  double rberWear;
+  double rberRetention;
+  double rberDisturb;
+  double correctableRBER;
+  double retryGain;
+  uint32_t maxRetry;
+  uint64_t decodeLatency;
+  uint64_t softDecodeLatency;
+  uint64_t initialRetention;
+
+  struct {
+    uint64_t count;
+    uint64_t retried;  //!< # reads which required at least one retry
+    uint64_t steps;    //!< Sum of retry steps
+    uint64_t soft;     //!< # reads which required soft decoding
+    double rber;       //!< Sum of RBER
+
+    std::vector<uint64_t> distribution;  //!< # reads by retry steps
+  } stat;
+
+  uint32_t getBlockIndex(::CPDPBP &);
+
+ public:
+  ReadRetry(Parameter &, ConfigReader &);
+  ~ReadRetry();
+
+  uint64_t read(::CPDPBP &, uint64_t, uint64_t);
+  void program(::CPDPBP &, uint64_t);
+  void erase(::CPDPBP &);
+
+  void getStatList(std::vector<Stats> &, std::string) override;
+  void getStatValues(std::vector<double> &) override;
+  void resetStatValues() override;
+};
+
+}  // namespace PAL
+
+}  // namespace SimpleSSD
+
+#endif
@@ -247,4 +247,8 @@ PAL::Config::NANDPower *ConfigReader::getNANDPower() {
   return palConfig.getNANDPower();
 }
 
+std::vector<PAL::Config::NANDZone> *ConfigReader::getNANDZone() {
+  return palConfig.getNANDZone();
+}
+
 }  // namespace SimpleSSD
@@ -81,6 +81,7 @@ class ConfigReader {
 
   PAL::Config::NANDTiming *getNANDTiming();
   PAL::Config::NANDPower *getNANDPower();
+  std::vector<PAL::Config::NANDZone> *getNANDZone();
 };
 
 }  // namespace SimpleSSD
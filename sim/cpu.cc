@@ -25,15 +25,16 @@ namespace SimpleSSD {
 CPU::CPU *cpu = nullptr;
 DMAFunction cpuHandler = commonCPUHandler;
 
-CPUContext::_CPUContext(DMAFunction &f, void *c) : func(f), context(c) {}
+CPUContext::_CPUContext(DMAFunction f, void *c)
+    : func(std::move(f)), context(c) {}
 
-CPUContext::_CPUContext(DMAFunction &f, void *c, CPU::NAMESPACE n,
+CPUContext::_CPUContext(DMAFunction f, void *c, CPU::NAMESPACE n,
                         CPU::FUNCTION fc)
-    : func(f), context(c), ns(n), fct(fc), delay(0) {}
+    : func(std::move(f)), context(c), ns(n), fct(fc), delay(0) {}
 
-CPUContext::_CPUContext(DMAFunction &f, void *c, CPU::NAMESPACE n,
+CPUContext::_CPUContext(DMAFunction f, void *c, CPU::NAMESPACE n,
                         CPU::FUNCTION fc, uint64_t d)
-    : func(f), context(c), ns(n), fct(fc), delay(d) {}
+    : func(std::move(f)), context(c), ns(n), fct(fc), delay(d) {}
 
 void initCPU(ConfigReader &conf) {
   if (cpu) {
@@ -79,11 +80,18 @@ void execute(CPU::NAMESPACE ns, CPU::FUNCTION fct, DMAFunction &func,
   }
 }
 
+void execute(CPU::NAMESPACE ns, CPU::FUNCTION fct, DMAFunction &&func,
+             void *context, uint64_t delay) {
+  if (cpu) {
+    cpu->execute(ns, fct, std::move(func), context, delay);
+  }
+}
+
 void commonCPUHandler(uint64_t, void *context) {
   CPUContext *pContext = (CPUContext *)context;
 
-  execute(pContext->ns, pContext->fct, pContext->func, pContext->context,
-          pContext->delay);
+  execute(pContext->ns, pContext->fct, std::move(pContext->func),
+          pContext->context, pContext->delay);
 
   delete pContext;
 }
@@ -37,9 +37,10 @@ typedef struct _CPUContext {
   CPU::FUNCTION fct;
   uint64_t delay;
 
-  _CPUContext(DMAFunction &, void *);
-  _CPUContext(DMAFunction &, void *, CPU::NAMESPACE, CPU::FUNCTION);
-  _CPUContext(DMAFunction &, void *, CPU::NAMESPACE, CPU::FUNCTION, uint64_t);
+  // Callback is taken by value, pass local function with std::move
+  _CPUContext(DMAFunction, void *);
+  _CPUContext(DMAFunction, void *, CPU::NAMESPACE, CPU::FUNCTION);
+  _CPUContext(DMAFunction, void *, CPU::NAMESPACE, CPU::FUNCTION, uint64_t);
 } CPUContext;
 
 void initCPU(ConfigReader &);
@@ -51,6 +52,8 @@ void printCPULastStat();
 
 void execute(CPU::NAMESPACE, CPU::FUNCTION, DMAFunction &, void * = nullptr,
              uint64_t = 0);
+void execute(CPU::NAMESPACE, CPU::FUNCTION, DMAFunction &&, void * = nullptr,
+             uint64_t = 0);
 uint64_t applyLatency(CPU::NAMESPACE, CPU::FUNCTION);
 
 void commonCPUHandler(uint64_t, void *);
@@ -107,6 +107,7 @@ const std::string logName[LOG_NUM] = {
     "FTL::PageMapping",   //!< LOG_FTL_PAGE_MAPPING
     "PAL",                //!< LOG_PAL
     "PAL::PALOLD",        //!< LOG_PAL_OLD
+    "PAL::EventPAL",      //!< LOG_PAL_EVENT
 };
 
 void debugprint(LOG_ID id, const char *format, ...) {
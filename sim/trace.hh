@@ -39,6 +39,7 @@ typedef enum {
   LOG_FTL_PAGE_MAPPING,
   LOG_PAL,
   LOG_PAL_OLD,
+  LOG_PAL_EVENT,
   LOG_NUM
 } LOG_ID;
 
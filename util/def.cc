@@ -35,6 +35,7 @@ Request::_Request()
       reqSubID(0),
       offset(0),
       length(0),
+      nsid(0),
       finishedAt(0),
       context(nullptr) {}
 
@@ -43,6 +44,7 @@ Request::_Request(DMAFunction &f, void *c)
       reqSubID(0),
       offset(0),
       length(0),
+      nsid(0),
       finishedAt(0),
       function(f),
       context(c) {}
@@ -55,27 +57,29 @@ bool Request::operator()(const Request &a, const Request &b) {
 
 namespace ICL {
 
-Request::_Request() : reqID(0), reqSubID(0), offset(0), length(0) {}
+Request::_Request() : reqID(0), reqSubID(0), offset(0), length(0), nsid(0) {}
 
 Request::_Request(HIL::Request &r)
     : reqID(r.reqID),
       reqSubID(r.reqSubID),
       offset(r.offset),
       length(r.length),
-      range(r.range) {}
+      range(r.range),
+      nsid(r.nsid) {}
 
 }  // namespace ICL
 
 namespace FTL {
 
 Request::_Request(uint32_t iocount)
-    : reqID(0), reqSubID(0), lpn(0), ioFlag(iocount) {}
+    : reqID(0), reqSubID(0), lpn(0), ioFlag(iocount), partialFlag(iocount) {}
 
 Request::_Request(uint32_t iocount, ICL::Request &r)
     : reqID(r.reqID),
       reqSubID(r.reqSubID),
       lpn(r.range.slpn / iocount),
-      ioFlag(iocount) {
+      ioFlag(iocount),
+      partialFlag(iocount) {
   ioFlag.set(r.range.slpn % iocount);
 }
 
@@ -45,6 +45,7 @@ typedef struct _Request {
   uint64_t offset;
   uint64_t length;
   LPNRange range;
+  uint32_t nsid;  // 0 when interface has no namespace
 
   uint64_t finishedAt;
   DMAFunction function;
@@ -66,6 +67,7 @@ typedef struct _Request {
   uint64_t offset;
   uint64_t length;
   LPNRange range;
+  uint32_t nsid;  // 0 when interface has no namespace
 
   _Request();
   _Request(HIL::Request &);
@@ -80,6 +82,7 @@ typedef struct _Request {
   uint64_t reqSubID;
   uint64_t lpn;
   Bitset ioFlag;
+  Bitset partialFlag;  // Subset of ioFlag holding partially written data
 
   _Request(uint32_t);
   _Request(uint32_t, ICL::Request &);
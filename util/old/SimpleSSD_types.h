@@ -177,6 +177,7 @@ enum {
   PAGE_LSB = 0,
   PAGE_CSB = 1,
   PAGE_MSB = 2,
+  PAGE_TSB = 3,
   PAGE_NUM
 };
 
@@ -185,6 +186,7 @@ enum {
   NAND_SLC,
   NAND_MLC,
   NAND_TLC,
+  NAND_QLC,
   NAND_NUM
 };
 